@@ -33,6 +33,13 @@ if (UNIX AND NOT APPLE)
   set(DGtalLibDependencies ${DGtalLibDependencies} -lrt)
 endif()
 
+# -----------------------------------------------------------------------------
+# Threads (std::thread, used e.g. by ImageCache prefetching)
+# -----------------------------------------------------------------------------
+find_package(Threads REQUIRED)
+target_link_libraries(DGtal PUBLIC Threads::Threads)
+set(DGtalLibDependencies ${DGtalLibDependencies} Threads::Threads)
+
 # -----------------------------------------------------------------------------
 # Eigen (already fetched)
 # -----------------------------------------------------------------------------
@@ -0,0 +1,417 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file CompressedIndexRanges.h
+ *
+ * Header file for the template class CompressedIndexRanges.
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(CompressedIndexRanges_RECURSES)
+#error Recursive header files inclusion detected in CompressedIndexRanges.h
+#else // defined(CompressedIndexRanges_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define CompressedIndexRanges_RECURSES
+
+#if !defined CompressedIndexRanges_h
+/** Prevents repeated inclusion of headers. */
+#define CompressedIndexRanges_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <boost/iterator/iterator_facade.hpp>
+#include "DGtal/base/Common.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class CompressedIndexRanges
+  /**
+   * Description of template class 'CompressedIndexRanges' <p>
+   * \brief Aim: Stores a sequence of ranges of indices (e.g. the
+   * vertices of each face of a mesh) as one offset array and one
+   * index array, instead of one std::vector per range. Each range is
+   * accessed as a lightweight non mutable view (see Range).
+   *
+   * Ranges may still be edited one index at a time (see add, remove
+   * and replace). A range whose size changes is moved to a side table,
+   * until compact() merges all the edited ranges back into the
+   * arrays.
+   *
+   * @note Views are invalidated by any modification of the object.
+   *
+   * @tparam TIndex the type of the stored indices.
+   */
+  template <typename TIndex>
+  class CompressedIndexRanges
+  {
+  public:
+    typedef TIndex                         Index;
+    typedef std::size_t                    Size;
+    typedef CompressedIndexRanges< Index > Self;
+    typedef std::vector< Index >           Indices;
+
+    /// A non mutable view on one range of indices. It provides the
+    /// usual services of a random access container (iteration,
+    /// size(), operator[], front(), back()), and converts to
+    /// std::vector when a copy is required.
+    class Range
+    {
+    public:
+      typedef Index        value_type;
+      typedef const Index& reference;
+      typedef const Index& const_reference;
+      typedef const Index* iterator;
+      typedef const Index* const_iterator;
+      typedef Size         size_type;
+
+      /// Default constructor (empty range).
+      Range() = default;
+      /// Constructor from a range of contiguous indices.
+      /// @param itb a pointer to the first index.
+      /// @param ite a pointer after the last index.
+      Range( const Index* itb, const Index* ite )
+        : myBegin( itb ), myEnd( ite ) {}
+
+      /// @return a pointer to the first index.
+      const_iterator begin()  const { return myBegin; }
+      /// @return a pointer after the last index.
+      const_iterator end()    const { return myEnd; }
+      /// @return a pointer to the first index.
+      const_iterator cbegin() const { return myBegin; }
+      /// @return a pointer after the last index.
+      const_iterator cend()   const { return myEnd; }
+      /// @return the number of indices.
+      Size size()  const { return myEnd - myBegin; }
+      /// @return 'true' if the range has no index.
+      bool empty() const { return myEnd == myBegin; }
+      /// @param i any position in the range.
+      /// @return the i-th index.
+      const Index& operator[]( Size i ) const { return myBegin[ i ]; }
+      /// @return the first index.
+      const Index& front() const { return *myBegin; }
+      /// @return the last index.
+      const Index& back()  const { return *( myEnd - 1 ); }
+      /// @return a copy of the indices.
+      operator Indices() const { return Indices( myBegin, myEnd ); }
+
+      /// @param other any range.
+      /// @return 'true' if both ranges have the same indices in the same order.
+      bool operator==( const Range& other ) const
+      { return size() == other.size() && std::equal( myBegin, myEnd, other.myBegin ); }
+      /// @param other any range.
+      /// @return 'true' if both ranges differ.
+      bool operator!=( const Range& other ) const
+      { return ! ( *this == other ); }
+      /// @param other any vector of indices.
+      /// @return 'true' if both have the same indices in the same order.
+      bool operator==( const Indices& other ) const
+      { return *this == Range( other.data(), other.data() + other.size() ); }
+      /// @param other any vector of indices.
+      /// @return 'true' if both differ.
+      bool operator!=( const Indices& other ) const
+      { return ! ( *this == other ); }
+      /// @param v any vector of indices.
+      /// @param range any range.
+      /// @return 'true' if both have the same indices in the same order.
+      friend bool operator==( const Indices& v, const Range& range )
+      { return range == v; }
+      /// @param v any vector of indices.
+      /// @param range any range.
+      /// @return 'true' if both differ.
+      friend bool operator!=( const Indices& v, const Range& range )
+      { return range != v; }
+
+    private:
+      const Index* myBegin = nullptr;
+      const Index* myEnd   = nullptr;
+    };
+
+    /// Non mutable iterator visiting the ranges in order.
+    class ConstIterator
+      : public boost::iterator_facade< ConstIterator, Range const,
+                                       boost::random_access_traversal_tag,
+                                       Range, std::ptrdiff_t >
+    {
+    public:
+      /// Default constructor.
+      ConstIterator() = default;
+      /// Constructor.
+      /// @param ranges the visited ranges.
+      /// @param r the index of the pointed range.
+      ConstIterator( const Self* ranges, Size r )
+        : myRanges( ranges ), myR( r ) {}
+    private:
+      friend class boost::iterator_core_access;
+      Range dereference() const { return ( *myRanges )[ myR ]; }
+      bool equal( const ConstIterator& other ) const { return myR == other.myR; }
+      void increment() { ++myR; }
+      void decrement() { --myR; }
+      void advance( std::ptrdiff_t n ) { myR += n; }
+      std::ptrdiff_t distance_to( const ConstIterator& other ) const
+      { return std::ptrdiff_t( other.myR ) - std::ptrdiff_t( myR ); }
+      const Self* myRanges = nullptr;
+      Size        myR      = 0;
+    };
+    typedef ConstIterator const_iterator;
+    typedef ConstIterator iterator;
+    typedef Range         value_type;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /// Default constructor: no range.
+    CompressedIndexRanges()
+      : myOffsets( 1, 0 ) {}
+
+    /// Constructor from a range of ranges of indices.
+    /// @tparam RangeIterator any forward iterator on ranges of indices.
+    /// @param itb the iterator on the first range.
+    /// @param ite the iterator after the last range.
+    template <typename RangeIterator>
+    CompressedIndexRanges( RangeIterator itb, RangeIterator ite )
+      : myOffsets( 1, 0 )
+    {
+      for ( ; itb != ite; ++itb )
+        push_back( itb->begin(), itb->end() );
+    }
+
+    /// Removes all the ranges.
+    void clear()
+    {
+      myOffsets.assign( 1, 0 );
+      myIndices.clear();
+      myIsEdited.clear();
+      myEditedRanges.clear();
+    }
+
+    /// Removes all the ranges and creates ranges of the given sizes,
+    /// filled with zeroes, whose indices may then be set with at().
+    /// @tparam SizeIterator any forward iterator on sizes.
+    /// @param itb the iterator on the size of the first range.
+    /// @param ite the iterator after the size of the last range.
+    template <typename SizeIterator>
+    void resize( SizeIterator itb, SizeIterator ite )
+    {
+      clear();
+      for ( ; itb != ite; ++itb )
+        myOffsets.push_back( myOffsets.back() + *itb );
+      myIndices.assign( myOffsets.back(), Index( 0 ) );
+    }
+
+    /// Appends a range of indices.
+    /// @tparam IndexIterator any forward iterator on indices.
+    /// @param itb the iterator on the first index.
+    /// @param ite the iterator after the last index.
+    template <typename IndexIterator>
+    void push_back( IndexIterator itb, IndexIterator ite )
+    {
+      myIndices.insert( myIndices.end(), itb, ite );
+      myOffsets.push_back( myIndices.size() );
+      if ( ! myIsEdited.empty() ) myIsEdited.push_back( false );
+    }
+
+    /// @return the number of ranges.
+    Size size() const
+    { return myOffsets.size() - 1; }
+
+    /// @return 'true' if there is no range.
+    bool empty() const
+    { return size() == 0; }
+
+    /// @return the total number of indices of all the ranges.
+    Size nbIndices() const
+    {
+      Size n = myIndices.size();
+      for ( const auto& r : myEditedRanges )
+        n += r.second.size() - ( myOffsets[ r.first + 1 ] - myOffsets[ r.first ] );
+      return n;
+    }
+
+    /// @param r any valid range number.
+    /// @return a view on the range \a r.
+    Range operator[]( Size r ) const
+    {
+      if ( ! myEditedRanges.empty() && myIsEdited[ r ] )
+        {
+          const Indices& v = myEditedRanges.find( r )->second;
+          return Range( v.data(), v.data() + v.size() );
+        }
+      return Range( myIndices.data() + myOffsets[ r ],
+                    myIndices.data() + myOffsets[ r + 1 ] );
+    }
+
+    /// @return an iterator on the first range.
+    ConstIterator begin() const
+    { return ConstIterator( this, 0 ); }
+
+    /// @return an iterator after the last range.
+    ConstIterator end() const
+    { return ConstIterator( this, size() ); }
+
+    /// @param r any valid range number.
+    /// @param k any valid position in this range.
+    /// @return a mutable reference on the k-th index of range \a r.
+    /// @note Distinct ranges may be written in parallel.
+    Index& at( Size r, Size k )
+    {
+      if ( ! myEditedRanges.empty() && myIsEdited[ r ] )
+        return myEditedRanges.find( r )->second[ k ];
+      return myIndices[ myOffsets[ r ] + k ];
+    }
+
+    /// Appends the index \a i to the range \a r.
+    /// @param r any valid range number.
+    /// @param i any index.
+    void add( Size r, Index i )
+    {
+      edit( r ).push_back( i );
+    }
+
+    /// Removes the index \a i from the range \a r, by moving the last
+    /// index of the range at its place.
+    /// @param r any valid range number.
+    /// @param i any index.
+    /// @return 'true' if \a i was in the range, 'false' otherwise.
+    bool remove( Size r, Index i )
+    {
+      const Range range = ( *this )[ r ];
+      const auto  it    = std::find( range.begin(), range.end(), i );
+      if ( it == range.end() ) return false;
+      const Size k  = it - range.begin();
+      Indices&   v  = edit( r );
+      std::swap( v[ k ], v.back() );
+      v.pop_back();
+      return true;
+    }
+
+    /// Replaces the index \a i with the index \a ri in the range \a r.
+    /// @param r any valid range number.
+    /// @param i any index.
+    /// @param ri any index.
+    /// @return 'true' if \a i was in the range, 'false' otherwise.
+    bool replace( Size r, Index i, Index ri )
+    {
+      const Range range = ( *this )[ r ];
+      const auto  it    = std::find( range.begin(), range.end(), i );
+      if ( it == range.end() ) return false;
+      at( r, it - range.begin() ) = ri;
+      return true;
+    }
+
+    /// Merges the edited ranges back into the offset and index arrays.
+    void compact()
+    {
+      if ( myEditedRanges.empty() ) return;
+      Self other;
+      other.myOffsets.reserve( myOffsets.size() );
+      other.myIndices.reserve( nbIndices() );
+      for ( const auto range : *this )
+        other.push_back( range.begin(), range.end() );
+      *this = std::move( other );
+    }
+
+    /// @return a copy of the ranges as a vector of vectors.
+    operator std::vector< Indices >() const
+    { return std::vector< Indices >( begin(), end() ); }
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const
+    {
+      out << "[CompressedIndexRanges #R=" << size()
+          << " #I=" << nbIndices()
+          << " #edited=" << myEditedRanges.size() << "]";
+    }
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const
+    {
+      return ! myOffsets.empty() && myOffsets.back() == myIndices.size()
+        && ( myEditedRanges.empty() || myIsEdited.size() == size() );
+    }
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+    /// For each range r, the positions of its indices in myIndices
+    /// are [ myOffsets[ r ], myOffsets[ r + 1 ] ) (size is size()+1).
+    std::vector< Size >  myOffsets;
+    /// The indices of all the ranges, stored contiguously.
+    Indices              myIndices;
+    /// For each range, 'true' iff it is stored in myEditedRanges
+    /// (empty as long as no range has been edited).
+    std::vector< bool >  myIsEdited;
+    /// The ranges whose size has changed since the last compact().
+    std::unordered_map< Size, Indices > myEditedRanges;
+
+    // ------------------------- Internals ------------------------------------
+  private:
+
+    /// Moves the range \a r to the side table, if it is not already there.
+    /// @param r any valid range number.
+    /// @return a reference to the edited range.
+    Indices& edit( Size r )
+    {
+      if ( myIsEdited.empty() ) myIsEdited.assign( size(), false );
+      if ( ! myIsEdited[ r ] )
+        {
+          myIsEdited[ r ] = true;
+          return myEditedRanges[ r ] = Indices( myIndices.begin() + myOffsets[ r ],
+                                                myIndices.begin() + myOffsets[ r + 1 ] );
+        }
+      return myEditedRanges.find( r )->second;
+    }
+
+  }; // end of class CompressedIndexRanges
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'CompressedIndexRanges'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'CompressedIndexRanges' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TIndex>
+  std::ostream&
+  operator<< ( std::ostream & out, const CompressedIndexRanges<TIndex> & object )
+  {
+    object.selfDisplay( out );
+    return out;
+  }
+
+} // namespace DGtal
+
+#endif // !defined CompressedIndexRanges_h
+
+#undef CompressedIndexRanges_RECURSES
+#endif // else defined(CompressedIndexRanges_RECURSES)
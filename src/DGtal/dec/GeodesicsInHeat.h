@@ -41,6 +41,13 @@
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 #include "DGtal/base/Common.h"
 #include "DGtal/base/ConstAlias.h"
 #include "DGtal/math/linalg/DirichletConditions.h"
@@ -56,6 +63,12 @@ namespace DGtal
    *
    * see @ref moduleGeodesicsInHeat for details and examples.
    *
+   * The heat and Poisson systems are prefactored once by init(). The
+   * distance fields to many seeds may then be computed at once by
+   * computeBatch(), which solves multi-column right-hand sides, and
+   * the prefactored systems may be saved to disk and reloaded for a
+   * mesh that is queried repeatedly (see save() and load()).
+   *
    * @tparam a model of PolygonalCalculus.
    */
   template <typename TPolygonalCalculus>
@@ -73,6 +86,100 @@ namespace DGtal
     typedef typename PolygonalCalculus::LinAlg LinAlgBackend;
     typedef DirichletConditions< LinAlgBackend > Conditions;
     typedef typename Conditions::IntegerVector IntegerVector;
+
+    /**
+     * A prefactored symmetric sparse system, stored as the \f$ LDL^T
+     * \f$ decomposition of a permutation of its matrix (as computed
+     * by Eigen::SimplicialLDLT). Contrary to the Eigen solver, the
+     * factors can be saved to and loaded from a binary stream.
+     */
+    struct Factorization
+    {
+      /// The strictly lower part of the unit lower triangular factor.
+      SparseMatrix L;
+      /// The diagonal factor.
+      Vector D;
+      /// The fill-in reducing permutation (indices of Eigen::PermutationMatrix).
+      Eigen::Matrix<typename SparseMatrix::StorageIndex, Eigen::Dynamic, 1> P;
+
+      /// Prefactors the matrix @a A.
+      /// @param A a symmetric sparse matrix.
+      /// @return 'true' if the factorization succeeded.
+      bool compute( const SparseMatrix & A )
+      {
+        Solver solver( A );
+        if ( solver.info() != Eigen::Success ) return false;
+        L = solver.matrixL().nestedExpression();
+        D = solver.vectorD();
+        P = solver.permutationP().indices();
+        return true;
+      }
+
+      /// Solves \f$ AX = B \f$ for one or several right-hand sides.
+      /// @param B a vector or a dense matrix (one column per right-hand side).
+      /// @return the solution X, of the same type as @a B.
+      template <typename TDense>
+      TDense solve( const TDense & B ) const
+      {
+        TDense X( B.rows(), B.cols() );
+        for ( Eigen::Index i = 0; i < B.rows(); ++i )
+          X.row( P[ i ] ) = B.row( i );
+        L.template triangularView<Eigen::UnitLower>().solveInPlace( X );
+        X = D.asDiagonal().inverse() * X;
+        L.transpose().template triangularView<Eigen::UnitUpper>().solveInPlace( X );
+        TDense Y( B.rows(), B.cols() );
+        for ( Eigen::Index i = 0; i < B.rows(); ++i )
+          Y.row( i ) = X.row( P[ i ] );
+        return Y;
+      }
+
+      /// Writes the factors in binary form.
+      /// @param out any output stream.
+      void save( std::ostream & out ) const
+      {
+        SparseMatrix Lc = L;
+        Lc.makeCompressed();
+        writeBinary( out, Lc.rows() );
+        writeBinary( out, Lc.nonZeros() );
+        writeBinary( out, Lc.outerIndexPtr(), Lc.outerSize() + 1 );
+        writeBinary( out, Lc.innerIndexPtr(), Lc.nonZeros() );
+        writeBinary( out, Lc.valuePtr(), Lc.nonZeros() );
+        writeBinary( out, D.data(), D.size() );
+        writeBinary( out, P.data(), P.size() );
+      }
+
+      /// Reads factors written by save().
+      /// @param in any input stream.
+      /// @param size the expected size of the factored system.
+      /// @return 'true' if the factors were read and are consistent
+      /// (size, sparse structure and permutation), 'false' otherwise.
+      bool load( std::istream & in, Eigen::Index size )
+      {
+        Eigen::Index n = 0, nnz = 0;
+        if ( ! readBinary( in, n ) || ! readBinary( in, nnz )
+             || n != size || nnz < 0 || nnz > n * n )
+          return false;
+        L.resize( n, n );
+        L.resizeNonZeros( nnz );
+        D.resize( n );
+        P.resize( n );
+        if ( ! readBinary( in, L.outerIndexPtr(), n + 1 )
+             || ! readBinary( in, L.innerIndexPtr(), nnz )
+             || ! readBinary( in, L.valuePtr(), nnz )
+             || ! readBinary( in, D.data(), n )
+             || ! readBinary( in, P.data(), n )
+             || ! isValidPattern( L, nnz ) )
+          return false;
+        // P must be a permutation of [0,n)
+        std::vector<bool> seen( n, false );
+        for ( Eigen::Index i = 0; i < n; ++i )
+          {
+            if ( P[ i ] < 0 || P[ i ] >= n || seen[ P[ i ] ] ) return false;
+            seen[ P[ i ] ] = true;
+          }
+        return true;
+      }
+    };
     
     /**
      * Default constructor.
@@ -151,8 +258,8 @@ namespace DGtal
       laplacian += 1e-6 * Id;
       
       //Prefactorizing
-      myPoissonSolver.compute( laplacian );
-      myHeatSolver.compute   ( myHeatOpe );
+      myPoissonFactor.compute( laplacian );
+      myHeatFactor.compute   ( myHeatOpe );
       
       //empty source
       mySource    = Vector::Zero(myCalculus->nbVertices());
@@ -174,7 +281,7 @@ namespace DGtal
       // Prepare solver for a problem with Dirichlet conditions.
       SparseMatrix heatOpe_d = Conditions::dirichletOperator( myHeatOpe, myBoundary );
       // Prefactoring
-      myHeatDirichletSolver.compute( heatOpe_d );
+      myHeatDirichletFactor.compute( heatOpe_d );
     }
     
     /** Adds a source point at a vertex @e aV
@@ -209,83 +316,303 @@ namespace DGtal
     Vector compute() const
     {
       FATAL_ERROR_MSG(myIsInit, "init() method must be called first");
+      return distancesFromSources( mySource, { myLastSourceIndex }, false ).col( 0 );
+    }
+
+    /// Computes the geodesic distances to several seeds at once, each
+    /// seed being considered independently: column k is the distance
+    /// field that compute() would return with @a seeds[k] as only
+    /// source. The prefactored systems are solved with multi-column
+    /// right-hand sides, and, when @a parallel is 'true' and OpenMP is
+    /// available, the columns are split into one block per thread for
+    /// the linear solves. The per face operators are evaluated by a
+    /// single thread, once per face for all the seeds.
+    ///
+    /// @param seeds the seed vertices.
+    /// @param parallel when 'true', blocks of seeds are solved in parallel.
+    /// @returns a nbVertices x seeds.size() matrix of geodesic distances.
+    DenseMatrix computeBatch( const std::vector<Vertex> & seeds,
+                              bool parallel = true ) const
+    {
+      FATAL_ERROR_MSG(myIsInit, "init() method must be called first");
+      const Eigen::Index nv = myCalculus->nbVertices();
+      DenseMatrix sources = DenseMatrix::Zero( nv, seeds.size() );
+      for ( std::size_t k = 0; k < seeds.size(); ++k )
+        {
+          ASSERT_MSG(seeds[ k ] < myCalculus->nbVertices(), "Vertex is not in the surface mesh vertex range");
+          sources( seeds[ k ], k ) = 1.0;
+        }
+      return distancesFromSources( sources, seeds, parallel );
+    }
+
+    /// Saves the prefactored systems (and the boundary conditions) in
+    /// binary form, so that they can be reloaded with load() for the
+    /// same surface mesh.
+    /// @param out any output stream, opened in binary mode.
+    /// @return 'true' if the object was written.
+    bool save( std::ostream & out ) const
+    {
+      FATAL_ERROR_MSG(myIsInit, "init() method must be called first");
+      const std::string magic = "DGtalGeodesicsInHeat1";
+      out.write( magic.data(), magic.size() );
+      writeBinary( out, (Eigen::Index) myCalculus->nbVertices() );
+      writeBinary( out, myLambda );
+      writeBinary( out, myManageBoundary );
+      myHeatFactor.save( out );
+      myPoissonFactor.save( out );
+      if ( myManageBoundary )
+        {
+          SparseMatrix H = myHeatOpe;
+          H.makeCompressed();
+          writeBinary( out, H.nonZeros() );
+          writeBinary( out, H.outerIndexPtr(), H.outerSize() + 1 );
+          writeBinary( out, H.innerIndexPtr(), H.nonZeros() );
+          writeBinary( out, H.valuePtr(), H.nonZeros() );
+          writeBinary( out, myBoundary.data(), myBoundary.size() );
+          myHeatDirichletFactor.save( out );
+        }
+      return out.good();
+    }
+
+    /// Saves the prefactored systems to a file.
+    /// @param filename the name of the output file.
+    /// @return 'true' if the file was written.
+    bool save( const std::string & filename ) const
+    {
+      std::ofstream out( filename, std::ios::binary );
+      return out.good() && save( out );
+    }
+
+    /// Loads prefactored systems written by save(), in place of
+    /// init(). The calculus must be built on the same surface mesh.
+    /// @param in any input stream, opened in binary mode.
+    /// @return 'true' if the object was read, in which case it is valid.
+    bool load( std::istream & in )
+    {
+      const std::string magic = "DGtalGeodesicsInHeat1";
+      std::string header( magic.size(), ' ' );
+      in.read( &header[ 0 ], header.size() );
+      Eigen::Index nv = 0;
+      myIsInit = false;
+      if ( in.fail() || header != magic
+           || ! readBinary( in, nv ) || nv != (Eigen::Index) myCalculus->nbVertices()
+           || ! readBinary( in, myLambda ) || ! readBinary( in, myManageBoundary )
+           || ! myHeatFactor.load( in, nv ) || ! myPoissonFactor.load( in, nv ) )
+        return false;
+      if ( myManageBoundary )
+        {
+          Eigen::Index nnz = 0;
+          if ( ! readBinary( in, nnz ) || nnz < 0 || nnz > nv * nv ) return false;
+          myHeatOpe.resize( nv, nv );
+          myHeatOpe.resizeNonZeros( nnz );
+          myBoundary.resize( nv );
+          if ( ! readBinary( in, myHeatOpe.outerIndexPtr(), nv + 1 )
+               || ! readBinary( in, myHeatOpe.innerIndexPtr(), nnz )
+               || ! readBinary( in, myHeatOpe.valuePtr(), nnz )
+               || ! readBinary( in, myBoundary.data(), nv )
+               || ! isValidPattern( myHeatOpe, nnz ) )
+            return false;
+          // The Dirichlet system is restricted to the non boundary vertices.
+          const Eigen::Index nbInner = (Eigen::Index) ( myBoundary.array() == 0 ).count();
+          if ( ! myHeatDirichletFactor.load( in, nbInner ) )
+            return false;
+        }
+      mySource = Vector::Zero( nv );
+      myIsInit = true;
+      return true;
+    }
+
+    /// Loads prefactored systems from a file written by save().
+    /// @param filename the name of the input file.
+    /// @return 'true' if the file was read.
+    bool load( const std::string & filename )
+    {
+      std::ifstream in( filename, std::ios::binary );
+      return in.good() && load( in );
+    }
+
+    /// @return true if the calculus is valid.
+    bool isValid() const
+    {
+      return myIsInit && myCalculus->isValid();
+    }
+    
+    // ----------------------- Private --------------------------------------
+
+  private:
+
+    /// Computes the geodesic distances for several heat sources.
+    /// @param sources a matrix with one column of sources per field.
+    /// @param shiftVertices for each column, the vertex whose distance is shifted to 0.
+    /// @param parallel when 'true', the linear solves are split in blocks of columns.
+    /// @return the distance fields, one per column.
+    DenseMatrix distancesFromSources( const DenseMatrix & sources,
+                                      const std::vector<Vertex> & shiftVertices,
+                                      bool parallel ) const
+    {
+      const auto nv = myCalculus->nbVertices();
+      const Eigen::Index nb = sources.cols();
       //Heat diffusion
-      Vector heatDiffusion = myHeatSolver.solve(mySource);
-      ASSERT(myHeatSolver.info()==Eigen::Success);
+      DenseMatrix heatDiffusion = solveByBlocks( myHeatFactor, sources, parallel );
 
       // Take care of boundaries
       if ( myManageBoundary )
         {
-          Vector bValues  = Vector::Zero( myCalculus->nbVertices() );
-          Vector bSources = Conditions::dirichletVector( myHeatOpe, mySource,
-                                                         myBoundary, bValues );
-          Vector bSol     = myHeatDirichletSolver.solve( bSources );
-          Vector heatDiffusionDirichlet
-                          = Conditions::dirichletSolution( bSol, myBoundary, bValues );
-          heatDiffusion = 0.5 * ( heatDiffusion + heatDiffusionDirichlet );
+#ifdef WITH_OPENMP
+          #pragma omp parallel for schedule(dynamic) if( parallel && nb > 1 )
+#endif
+          for ( Eigen::Index k = 0; k < nb; ++k )
+            {
+              Vector bValues  = Vector::Zero( nv );
+              Vector bSources = Conditions::dirichletVector( myHeatOpe, sources.col( k ),
+                                                             myBoundary, bValues );
+              Vector bSol     = myHeatDirichletFactor.solve( bSources );
+              Vector heatDiffusionDirichlet
+                              = Conditions::dirichletSolution( bSol, myBoundary, bValues );
+              heatDiffusion.col( k ) = 0.5 * ( heatDiffusion.col( k ) + heatDiffusionDirichlet );
+            }
+        }
+
+      // The per face operators may be stored in the calculus cache,
+      // hence they are evaluated by this thread only.
+      const DenseMatrix divergence = normalizedGradientDivergence( heatDiffusion );
+
+      // Last Poisson solve
+      DenseMatrix distances = solveByBlocks( myPoissonFactor, divergence, parallel );
+
+      //shifting the distances to get 0 at sources
+      for ( Eigen::Index k = 0; k < nb; ++k )
+        distances.col( k ).array() -= distances( shiftVertices[ k ], k );
+      return distances;
+    }
+
+    /// Solves a prefactored system for several right-hand sides. When
+    /// @a parallel is 'true' and OpenMP is available, the columns are
+    /// split into one block per thread.
+    /// @param factor a prefactored system.
+    /// @param B the right-hand sides, one per column.
+    /// @param parallel when 'true', blocks of columns are solved in parallel.
+    /// @return the solutions, one per column.
+    static DenseMatrix solveByBlocks( const Factorization & factor,
+                                      const DenseMatrix & B, bool parallel )
+    {
+      const Eigen::Index nb = B.cols();
+      int nbBlocks = nb > 0 ? 1 : 0;
+#ifdef WITH_OPENMP
+      if ( parallel )
+        nbBlocks = (int) std::min<Eigen::Index>( nb, omp_get_max_threads() );
+#else
+      (void) parallel;
+#endif
+      if ( nbBlocks <= 1 ) return factor.solve( B );
+      DenseMatrix X( B.rows(), nb );
+#ifdef WITH_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for ( int b = 0; b < nbBlocks; ++b )
+        {
+          const Eigen::Index first = ( nb * b ) / nbBlocks;
+          const Eigen::Index last  = ( nb * ( b + 1 ) ) / nbBlocks;
+          X.middleCols( first, last - first )
+            = factor.solve( DenseMatrix( B.middleCols( first, last - first ) ) );
         }
-      Vector divergence    = Vector::Zero(myCalculus->nbVertices());
+      return X;
+    }
+
+    /// @param heatDiffusion the diffused heat at each vertex, one field per column.
+    /// @return the divergence of the normalized heat gradient, one field per column.
+    DenseMatrix normalizedGradientDivergence( const DenseMatrix & heatDiffusion ) const
+    {
+      const Eigen::Index nb = heatDiffusion.cols();
+      DenseMatrix divergence = DenseMatrix::Zero( myCalculus->nbVertices(), nb );
       auto cpt=0;
       auto surfmesh = myCalculus->getSurfaceMeshPtr();
-      
-      // Heat, normalization and divergence per face
+
+      // Heat, normalization and divergence per face, for all the fields
       for(typename PolygonalCalculus::MySurfaceMesh::Index f=0; f< myCalculus->nbFaces(); ++f)
         {
-          Vector faceHeat( myCalculus->degree(f));
+          DenseMatrix faceHeat( myCalculus->degree(f), nb );
           cpt=0;
-          auto vertices = surfmesh->incidentVertices(f);
+          const auto &vertices = surfmesh->incidentVertices(f);
           for(auto v: vertices)
             {
-              faceHeat(cpt) = heatDiffusion( v );
+              faceHeat.row(cpt) = heatDiffusion.row( v );
               ++cpt;
             }
           // ∇heat / ∣∣∇heat∣∣
-          Vector grad = -myCalculus->gradient(f) * faceHeat;
-          grad.normalize();
-      
+          DenseMatrix grad = -myCalculus->gradient(f) * faceHeat;
+          for ( Eigen::Index k = 0; k < nb; ++k )
+            grad.col( k ).normalize();
+
           // div
-          DenseMatrix   oneForm = myCalculus->flat(f)*grad;
-          Vector divergenceFace = myCalculus->divergence( f ) * oneForm;
+          DenseMatrix divergenceFace = myCalculus->divergence( f ) * ( myCalculus->flat(f) * grad );
           cpt=0;
           for(auto v: vertices)
             {
-              divergence(v) += divergenceFace(cpt);
+              divergence.row(v) += divergenceFace.row(cpt);
               ++cpt;
             }
         }
-      
-      // Last Poisson solve
-      Vector distVec = myPoissonSolver.solve(divergence);
-      ASSERT(myPoissonSolver.info()==Eigen::Success);
+      return divergence;
+    }
 
-      //Source val
-      auto sourceval = distVec(myLastSourceIndex);
-      //shifting the distances to get 0 at sources
-      return distVec - sourceval*Vector::Ones(myCalculus->nbVertices());
+    /// Checks the compressed storage of a sparse matrix read from a
+    /// stream: the outer indices are non-decreasing from 0 to @a nnz
+    /// and the inner indices lie in [0, A.innerSize()).
+    /// @param A a compressed sparse matrix.
+    /// @param nnz the number of stored coefficients.
+    /// @return 'true' if the storage of @a A is consistent.
+    static bool isValidPattern( const SparseMatrix & A, Eigen::Index nnz )
+    {
+      const auto * outer = A.outerIndexPtr();
+      const auto * inner = A.innerIndexPtr();
+      if ( outer[ 0 ] != 0 || outer[ A.outerSize() ] != nnz ) return false;
+      for ( Eigen::Index k = 0; k < A.outerSize(); ++k )
+        if ( outer[ k ] > outer[ k + 1 ] ) return false;
+      for ( Eigen::Index i = 0; i < nnz; ++i )
+        if ( inner[ i ] < 0 || inner[ i ] >= A.innerSize() ) return false;
+      return true;
     }
-    
-    
-    /// @return true if the calculus is valid.
-    bool isValid() const
+
+    /// Writes @a n values in binary form.
+    template <typename T>
+    static void writeBinary( std::ostream & out, const T * values, Eigen::Index n )
     {
-      return myIsInit && myCalculus->isValid();
+      out.write( reinterpret_cast<const char*>( values ), n * sizeof( T ) );
+    }
+    /// Writes a value in binary form.
+    template <typename T>
+    static void writeBinary( std::ostream & out, const T & value )
+    {
+      writeBinary( out, &value, 1 );
+    }
+    /// Reads @a n values in binary form.
+    /// @return 'true' if the values were read.
+    template <typename T>
+    static bool readBinary( std::istream & in, T * values, Eigen::Index n )
+    {
+      in.read( reinterpret_cast<char*>( values ), n * sizeof( T ) );
+      return ! in.fail();
+    }
+    /// Reads a value in binary form.
+    /// @return 'true' if the value was read.
+    template <typename T>
+    static bool readBinary( std::istream & in, T & value )
+    {
+      return readBinary( in, &value, 1 );
     }
-    
-    // ----------------------- Private --------------------------------------
 
-  private:
-    
     ///The underlying PolygonalCalculus instance
     const PolygonalCalculus *myCalculus;
 
     /// The operator for heat diffusion.
     SparseMatrix myHeatOpe;
     
-    ///Poisson solver
-    Solver myPoissonSolver;
+    ///Prefactored Poisson system
+    Factorization myPoissonFactor;
 
-    ///Heat solver
-    Solver myHeatSolver;
+    ///Prefactored heat system
+    Factorization myHeatFactor;
 
     ///Source vector
     Vector mySource;
@@ -306,8 +633,8 @@ namespace DGtal
     /// The boundary characteristic vector
     IntegerVector myBoundary;
     
-    ///Heat solver with Dirichlet boundary conditions.
-    Solver myHeatDirichletSolver;
+    ///Prefactored heat system with Dirichlet boundary conditions.
+    Factorization myHeatDirichletFactor;
   
   
   }; // end of class GeodesicsInHeat
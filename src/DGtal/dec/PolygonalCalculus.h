@@ -35,6 +35,9 @@
 #include <string>
 #include <map>
 #include <unordered_map>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 #include "DGtal/base/ConstAlias.h"
 #include "DGtal/base/Common.h"
 #include "DGtal/shapes/SurfaceMesh.h"
@@ -186,6 +189,9 @@ public:
   /// @param surf an instance of SurfaceMesh
   /// @param embedder an embedder for the vertex position
   /// @param globalInternalCacheEnabled if true, the global operator cache is enabled
+  /// @note With WITH_OPENMP, global operators are assembled in
+  /// parallel and @a embedder is called concurrently from several
+  /// threads: it must be thread-safe (e.g. no unprotected cache).
   PolygonalCalculus(const ConstAlias<MySurfaceMesh> surf,
                     const std::function<Real3dPoint(Face,Vertex)> &embedder,
                     bool globalInternalCacheEnabled = false):
@@ -199,8 +205,11 @@ public:
   /// and an embedder for the vertex normal: function with a vertex as
   /// parameter which outputs the embedding in R^3 of the vertex normal.
   /// @param surf an instance of SurfaceMesh
-  /// @param embedder an embedder for the vertex position
+  /// @param embedder an embedder for the vertex normal
   /// @param globalInternalCacheEnabled if true, the global operator cache is enabled
+  /// @note With WITH_OPENMP, global operators are assembled in
+  /// parallel and @a embedder is called concurrently from several
+  /// threads: it must be thread-safe (e.g. no unprotected cache).
   PolygonalCalculus(const ConstAlias<MySurfaceMesh> surf,
                     const std::function<Real3dVector(Vertex)> &embedder,
                     bool globalInternalCacheEnabled = false):
@@ -221,6 +230,9 @@ public:
   /// @param pos_embedder an embedder for the position
   /// @param normal_embedder an embedder for the position
   /// @param globalInternalCacheEnabled
+  /// @note With WITH_OPENMP, global operators are assembled in
+  /// parallel and both embedders are called concurrently from several
+  /// threads: they must be thread-safe (e.g. no unprotected cache).
   PolygonalCalculus(const ConstAlias<MySurfaceMesh> surf,
                     const std::function<Real3dPoint(Face,Vertex)> &pos_embedder,
                     const std::function<Vector(Vertex)> &normal_embedder,
@@ -277,6 +289,9 @@ public:
   
   /// Update the embedding function.
   /// @param externalFunctor a new embedding functor (Face,Vertex)->RealPoint.
+  /// @note With WITH_OPENMP, @a externalFunctor is called concurrently
+  /// from several threads when global operators are assembled: it
+  /// must be thread-safe.
   void setEmbedder(const std::function<Real3dPoint(Face,Vertex)> &externalFunctor)
   {
     myEmbedder = externalFunctor;
@@ -855,12 +870,12 @@ public:
   SparseMatrix globalLaplaceBeltrami(const double lambda=1.0) const
   {
     SparseMatrix lapGlobal(mySurfaceMesh->nbVertices(), mySurfaceMesh->nbVertices());
-    std::vector<Triplet> triplets;
-    for( typename MySurfaceMesh::Index f = 0; f < mySurfaceMesh->nbFaces(); ++f )
+    assemble(lapGlobal, mySurfaceMesh->nbFaces(),
+             [&](const Face f, std::vector<Triplet> &triplets)
     {
       auto nf = myFaceDegree[f];
       DenseMatrix Lap = this->laplaceBeltrami(f,lambda);
-      const auto vertices = mySurfaceMesh->incidentVertices(f);
+      const auto &vertices = mySurfaceMesh->incidentVertices(f);
       for(auto i=0u; i < nf; ++i)
         for(auto j=0u; j < nf; ++j)
         {
@@ -869,8 +884,7 @@ public:
             triplets.emplace_back( Triplet( (SparseMatrix::StorageIndex)vertices[ i ], (SparseMatrix::StorageIndex)vertices[ j ],
                                             Lap( i, j ) ) );
         }
-    }
-    lapGlobal.setFromTriplets(triplets.begin(), triplets.end());
+    });
     return lapGlobal;
   }
   
@@ -882,16 +896,16 @@ public:
   SparseMatrix globalLumpedMassMatrix() const
   {
     SparseMatrix M(mySurfaceMesh->nbVertices(), mySurfaceMesh->nbVertices());
-    std::vector<Triplet> triplets;
-    for ( typename MySurfaceMesh::Index v = 0; v < mySurfaceMesh->nbVertices(); ++v )
+    const std::vector<double> weights = faceMassWeights();
+    assemble(M, mySurfaceMesh->nbVertices(),
+             [&](const Vertex v, std::vector<Triplet> &triplets)
       {
-        auto faces = mySurfaceMesh->incidentFaces(v);
+        const auto &faces = mySurfaceMesh->incidentFaces(v);
         auto varea = 0.0;
         for(auto f: faces)
-          varea += faceArea(f) /(double)myFaceDegree[f];
+          varea += weights[f];
         triplets.emplace_back(Triplet(v,v,varea));
-      }
-    M.setFromTriplets(triplets.begin(),triplets.end());
+      });
     return M;
   }
 
@@ -929,13 +943,12 @@ public:
   {
     auto nv = mySurfaceMesh->nbVertices();
     SparseMatrix lapGlobal(2 * nv, 2 * nv);
-    SparseMatrix local(2 * nv, 2 * nv);
-    std::vector<Triplet> triplets;
-    for (typename MySurfaceMesh::Index f = 0; f < mySurfaceMesh->nbFaces(); f++)
+    assemble(lapGlobal, mySurfaceMesh->nbFaces(),
+             [&](const Face f, std::vector<Triplet> &triplets)
     {
-      auto nf             = degree(f);
-      DenseMatrix Lap     = connectionLaplacian(f,lambda);
-      const auto vertices = mySurfaceMesh->incidentVertices(f);
+      auto nf              = degree(f);
+      DenseMatrix Lap      = connectionLaplacian(f,lambda);
+      const auto &vertices = mySurfaceMesh->incidentVertices(f);
       for (auto i = 0u; i < nf; ++i)
         for (auto j = 0u; j < nf; ++j)
           for (short k1 = 0; k1 < 2; k1++)
@@ -946,8 +959,7 @@ public:
                 triplets.emplace_back(Triplet(2 * vertices[i] + k1,
                                                 2 * vertices[j] + k2, v));
             }
-    }
-    lapGlobal.setFromTriplets(triplets.begin(), triplets.end());
+    });
     return lapGlobal;
   }
 
@@ -961,17 +973,17 @@ public:
   {
     auto nv = mySurfaceMesh->nbVertices();
     SparseMatrix M(2 * nv, 2 * nv);
-    std::vector<Triplet> triplets;
-    for (typename MySurfaceMesh::Index v = 0; v < mySurfaceMesh->nbVertices(); ++v)
+    const std::vector<double> weights = faceMassWeights();
+    assemble(M, mySurfaceMesh->nbVertices(),
+             [&](const Vertex v, std::vector<Triplet> &triplets)
     {
-      auto faces = mySurfaceMesh->incidentFaces(v);
+      const auto &faces = mySurfaceMesh->incidentFaces(v);
       auto varea = 0.0;
       for (auto f : faces)
-        varea += faceArea(f) / (double)myFaceDegree[f];
+        varea += weights[f];
       triplets.emplace_back(Triplet(2 * v, 2 * v, varea));
       triplets.emplace_back(Triplet(2 * v + 1, 2 * v + 1, varea));
-    }
-    M.setFromTriplets(triplets.begin(), triplets.end());
+    });
     return M;
   }
   /// @}
@@ -1033,6 +1045,7 @@ public:
   void enableInternalGlobalCache()
   {
     myGlobalCacheEnabled = true;
+    resetGlobalCache();
   }
   
   /// Disable the internal global cache for operators.
@@ -1040,7 +1053,7 @@ public:
   void disableInternalGlobalCache()
   {
     myGlobalCacheEnabled = false;
-    myGlobalCache.clear();
+    resetGlobalCache();
   }
 
   /// @}
@@ -1055,6 +1068,7 @@ public:
   void init()
   {
     updateFaceDegree();
+    resetGlobalCache();
   }
   
   /// Helper to retrieve the degree of the face from the cache.
@@ -1143,13 +1157,11 @@ protected:
   /// @returns true if the operator "key" for the face f has been computed.
   bool checkCache(OPERATOR key, const Face f) const
   {
-    if (myGlobalCacheEnabled)
-      if (myGlobalCache[key].find(f) != myGlobalCache[key].end())
-        return true;
-    return false;
+    return myGlobalCacheEnabled && myGlobalCacheIsSet[key][f];
   }
 
-  /// Set an operator in the internal cache.
+  /// Set an operator in the internal cache. Different faces may be
+  /// set concurrently.
   /// @param key the operator name
   /// @param f the face
   /// @param ope the operator to store
@@ -1157,7 +1169,75 @@ protected:
                   const DenseMatrix &ope) const
   {
     if (myGlobalCacheEnabled)
-      myGlobalCache[key][f]  = ope;
+    {
+      myGlobalCache[key][f]      = ope;
+      myGlobalCacheIsSet[key][f] = 1;
+    }
+  }
+
+  /// Empties the internal cache, and allocates one slot per face and
+  /// per operator if the cache is enabled.
+  void resetGlobalCache()
+  {
+    const auto nbSlots = myGlobalCacheEnabled ? mySurfaceMesh->nbFaces() : 0;
+    for(auto k = 0u; k < myGlobalCache.size(); ++k)
+    {
+      myGlobalCache[k].clear();
+      myGlobalCache[k].resize(nbSlots);
+      myGlobalCacheIsSet[k].assign(nbSlots, 0);
+    }
+  }
+
+  /// Assembles a sparse matrix from the triplets output element per
+  /// element (face or vertex). With OpenMP, elements are split into
+  /// contiguous blocks, one per thread, each thread filling its own
+  /// triplet buffer. Buffers are concatenated in element order, so
+  /// that the result does not depend on the number of threads.
+  /// @param[in,out] M the sparse matrix (already sized).
+  /// @param nbElements the number of elements.
+  /// @param elementTriplets a functor (Index, std::vector<Triplet>&) that outputs the triplets of an element.
+  template <typename ElementTriplets>
+  void assemble(SparseMatrix &M, const size_t nbElements,
+                ElementTriplets elementTriplets) const
+  {
+    std::vector<std::vector<Triplet>> buffers;
+#ifdef WITH_OPENMP
+    buffers.resize(omp_get_max_threads());
+    #pragma omp parallel for schedule(static)
+#else
+    buffers.resize(1);
+#endif
+    //MSVC requires signed type for openmp
+    for(int e = 0; e < (int)nbElements; ++e)
+    {
+#ifdef WITH_OPENMP
+      elementTriplets(e, buffers[omp_get_thread_num()]);
+#else
+      elementTriplets(e, buffers[0]);
+#endif
+    }
+    std::vector<Triplet> triplets;
+    size_t nb = 0;
+    for(const auto &buffer: buffers)
+      nb += buffer.size();
+    triplets.reserve(nb);
+    for(const auto &buffer: buffers)
+      triplets.insert(triplets.end(), buffer.begin(), buffer.end());
+    M.setFromTriplets(triplets.begin(), triplets.end());
+  }
+
+  /// @return for each face, its area divided by its degree (computed
+  /// in parallel with OpenMP).
+  std::vector<double> faceMassWeights() const
+  {
+    std::vector<double> weights(mySurfaceMesh->nbFaces());
+#ifdef WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    //MSVC requires signed type for openmp
+    for(int f = 0; f < (int)weights.size(); ++f)
+      weights[f] = faceArea(f) / (double)myFaceDegree[f];
+    return weights;
   }
   
   /// Project u on the orthgonal of n
@@ -1286,9 +1366,11 @@ private:
   ///Cache containing the face degree
   std::vector<size_t> myFaceDegree;
     
-  ///Global cache
+  ///Global cache, indexed by operator then by face.
   bool myGlobalCacheEnabled;
-  mutable std::array<std::unordered_map<Face,DenseMatrix>, 15> myGlobalCache;
+  mutable std::array<std::vector<DenseMatrix>, 15> myGlobalCache;
+  ///Tells for each operator and each face if it is in the global cache.
+  mutable std::array<std::vector<char>, 15> myGlobalCacheIsSet;
   
 }; // end of class PolygonalCalculus
 
@@ -41,8 +41,12 @@
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
 #include <vector>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 #include "DGtal/kernel/CCommutativeRing.h"
 #include "DGtal/shapes/SurfaceMesh.h"
+#include "DGtal/shapes/SurfaceMeshSpatialIndex.h"
 
 namespace DGtal
 {
@@ -72,7 +76,9 @@ namespace DGtal
      specified by their indices through convenient methods like
      SurfaceMeshMeasure::vertexMeasure,
      SurfaceMeshMeasure::edgeMeasure, SurfaceMeshMeasure::faceMeasure,
-     with potential weights.
+     with potential weights. The measures of many balls, for instance
+     one per face or per vertex of the mesh, are computed in parallel
+     by SurfaceMeshMeasure::measures.
 
      @tparam TRealPoint an arbitrary model of RealPoint.
      @tparam TRealVector an arbitrary model of RealVector.
@@ -112,6 +118,8 @@ namespace DGtal
     typedef std::vector< WeightedVertex >  WeightedVertices;
     typedef std::vector< WeightedEdge >    WeightedEdges;
     typedef std::vector< WeightedFace >    WeightedFaces;
+    typedef std::vector< RealPoint >       RealPoints;
+    typedef SurfaceMeshSpatialIndex< RealPoint, RealVector > SpatialIndex;
     static const Dimension dimension = RealPoint::dimension;
 
     // ------------------------- Standard services ------------------------------
@@ -191,6 +199,70 @@ namespace DGtal
           return m;
         }
     }
+
+    /// Computes the total measures on the balls of centers \a x[i] and
+    /// radius \a r. Each center \a x[i] must lie on or close to the
+    /// face \a f[i]. Balls are processed in parallel when DGtal is
+    /// built with OpenMP.
+    ///
+    /// @param x the positions where the balls are centered.
+    /// @param r the radius of the balls.
+    /// @param f for each center, the face where it lies (same size as \a x).
+    /// @return the measure of each ball, in the order of \a x.
+    Values measures( const RealPoints& x, Scalar r, const Faces& f ) const
+    {
+      ASSERT( x.size() == f.size() );
+      Values m( x.size(), myZero );
+      const int nb = x.size();
+#ifdef WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for ( int i = 0; i < nb; ++i ) //MSVC requires signed type for openmp
+        m[ i ] = measure( x[ i ], r, f[ i ] );
+      return m;
+    }
+
+    /// Computes the total measure on the ball of center \a x and
+    /// radius \a r, where the cells in the ball are given by a spatial
+    /// index over the mesh. Contrary to the measure with a face hint,
+    /// the ball gathers all the cells close to \a x, even the ones
+    /// that are not connected to \a x within the ball.
+    ///
+    /// @param x the position where the ball is centered.
+    /// @param r the radius of the ball.
+    /// @param index a spatial index over the mesh of this measure.
+    Value measure( const RealPoint& x, Scalar r, const SpatialIndex& index ) const
+    {
+      ASSERT( &index.mesh() == myMeshPtr );
+      if ( vertex_measures.empty() && edge_measures.empty() )
+        return faceMeasure( index.computeFacesInclusionsInBall( r, x ) );
+      std::tuple< Vertices, WeightedEdges, WeightedFaces >
+        wcells = index.computeCellsInclusionsInBall( r, x );
+      Value m = vertexMeasure( std::get< 0 >( wcells ) );
+      m      += edgeMeasure  ( std::get< 1 >( wcells ) );
+      m      += faceMeasure  ( std::get< 2 >( wcells ) );
+      return m;
+    }
+
+    /// Computes the total measures on the balls of centers \a x[i] and
+    /// radius \a r, using a spatial index over the mesh. Balls are
+    /// processed in parallel when DGtal is built with OpenMP.
+    ///
+    /// @param x the positions where the balls are centered.
+    /// @param r the radius of the balls.
+    /// @param index a spatial index over the mesh of this measure.
+    /// @return the measure of each ball, in the order of \a x.
+    Values measures( const RealPoints& x, Scalar r, const SpatialIndex& index ) const
+    {
+      Values m( x.size(), myZero );
+      const int nb = x.size();
+#ifdef WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for ( int i = 0; i < nb; ++i ) //MSVC requires signed type for openmp
+        m[ i ] = measure( x[ i ], r, index );
+      return m;
+    }
       
     /// @param v any vertex index.
     /// @return its measure.
@@ -1192,6 +1192,37 @@ template< typename TF,  typename TKF, typename TKS, typename TDK >
 std::ostream&
 operator<< ( std::ostream & out, const DGtal::DigitalSurfaceConvolver<TF, TKF, TKS, TDK, 3 > & object );
 
+namespace detail
+{
+  /**
+   * Evaluates a convolver on a range of surfels and writes the
+   * results in order. With OpenMP and random access iterators, the
+   * range is split into contiguous chunks that are evaluated in
+   * parallel, otherwise the whole range is evaluated at once.
+   *
+   * @tparam TConvolver the type of convolver (e.g. DigitalSurfaceConvolver).
+   * @tparam TFunctor the type of functor applied to the convolutions, which defines a Quantity type.
+   * @tparam SurfelConstIterator the type of iterator on surfels.
+   * @tparam OutputIterator the type of output iterator on Quantity.
+   * @tparam RangeEvaluation the type of a callable (convolver, itb, ite, output, functor) evaluating a range.
+   *
+   * @param convolver the convolver.
+   * @param functor the functor applied to the convolutions.
+   * @param itb an iterator on the first surfel.
+   * @param ite an iterator after the last surfel.
+   * @param result an output iterator on the results.
+   * @param evalRange evaluates a range of surfels with @a convolver
+   * and @a functor, e.g. by calling DigitalSurfaceConvolver::eval.
+   * @return the output iterator after the last written result.
+   */
+  template < typename TConvolver, typename TFunctor, typename SurfelConstIterator,
+             typename OutputIterator, typename RangeEvaluation >
+  OutputIterator
+  evalByChunks( const TConvolver & convolver, const TFunctor & functor,
+                SurfelConstIterator itb, SurfelConstIterator ite,
+                OutputIterator result, RangeEvaluation evalRange );
+} // namespace detail
+
 
 } // namespace DGtal
 
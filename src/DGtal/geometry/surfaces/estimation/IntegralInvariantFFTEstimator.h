@@ -0,0 +1,337 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file IntegralInvariantFFTEstimator.h
+ *
+ * Header file for module IntegralInvariantFFTEstimator.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(IntegralInvariantFFTEstimator_RECURSES)
+#error Recursive header files inclusion detected in IntegralInvariantFFTEstimator.h
+#else // defined(IntegralInvariantFFTEstimator_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define IntegralInvariantFFTEstimator_RECURSES
+
+#if !defined IntegralInvariantFFTEstimator_h
+/** Prevents repeated inclusion of headers. */
+#define IntegralInvariantFFTEstimator_h
+
+#ifndef WITH_FFTW3
+  #error You need to have activated FFTW3 (WITH_FFTW3) to include this file.
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include <type_traits>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/CountedConstPtrOrConstPtr.h"
+#include "DGtal/kernel/CPointPredicate.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+#include "DGtal/topology/CCellularGridSpaceND.h"
+#include "DGtal/shapes/GaussDigitizer.h"
+#include "DGtal/shapes/implicit/ImplicitBall.h"
+#include "DGtal/math/RealFFT.h"
+#include "DGtal/geometry/surfaces/estimation/IIGeometricFunctors.h"
+//////////////////////////////////////////////////////////////////////////////
+
+
+namespace DGtal
+{
+
+/////////////////////////////////////////////////////////////////////////////
+// template class IntegralInvariantFFTEstimator
+/**
+* Description of template class 'IntegralInvariantFFTEstimator' <p>
+* \brief Aim: Integral Invariant estimator (see
+* IntegralInvariantVolumeEstimator and
+* IntegralInvariantCovarianceEstimator) computing the convolutions of
+* the shape with the ball kernel by Fast Fourier Transforms.
+*
+* At initialization, the characteristic function of the shape over
+* the domain of the cellular grid space is convolved once with the
+* digital ball kernel (volume) and, if the functor expects a
+* covariance matrix, with the moment kernels @f$ p_i @f$ and @f$ p_i
+* p_j @f$ (see RealFFT). The moments of the inner and outer spels of
+* the surfels given to init() are stored, hence evaluations are
+* lookups. Convolution results are rounded to the nearest integer
+* since shape and kernel moments are integers: volumes are the same
+* as the ones of IntegralInvariantVolumeEstimator and covariance
+* matrices only differ by floating-point rounding from the ones of
+* IntegralInvariantCovarianceEstimator (moments are centered on the
+* spel).
+*
+* The FFT cost only depends on the domain size, whereas the
+* per-surfel convolver cost grows with the number of surfels and the
+* kernel radius. isFasterThanConvolver() gives a rough crossover
+* estimation between both approaches.
+*
+* @tparam TKSpace a model of CCellularGridSpaceND, the cellular space
+* in which the shape is defined.
+*
+* @tparam TPointPredicate a model of concepts::CPointPredicate, a predicate
+* Point -> bool that defines a digital shape as a characteristic
+* function.
+*
+* @tparam TFunctor a model of functor Argument -> Quantity, where
+* Argument is either a scalar (volume, e.g.
+* IIGeometricFunctors::IIMeanCurvature3DFunctor) or a covariance
+* matrix (e.g. IIGeometricFunctors::IIGaussianCurvature3DFunctor).
+*
+* @see IntegralInvariantVolumeEstimator IntegralInvariantCovarianceEstimator RealFFT
+*/
+template <typename TKSpace, typename TPointPredicate, typename TFunctor>
+class IntegralInvariantFFTEstimator
+{
+public:
+  typedef IntegralInvariantFFTEstimator< TKSpace, TPointPredicate, TFunctor> Self;
+  typedef TKSpace KSpace;
+  typedef TPointPredicate PointPredicate;
+  typedef TFunctor Functor;
+
+  BOOST_CONCEPT_ASSERT (( concepts::CCellularGridSpaceND< KSpace > ));
+  BOOST_CONCEPT_ASSERT (( concepts::CPointPredicate< PointPredicate > ));
+
+  typedef typename KSpace::Space Space;
+  typedef HyperRectDomain<Space> Domain;
+  typedef typename Space::Point Point;
+  typedef typename Space::RealPoint RealPoint;
+  typedef typename Space::Dimension Dimension;
+  typedef typename KSpace::Surfel Surfel;
+
+  /// The returned type of the estimator, depends on the functor
+  typedef typename Functor::Quantity Quantity;
+  /// The argument of the functor: a volume or a covariance matrix.
+  typedef typename Functor::Argument Argument;
+  /// True if the functor expects a volume, false for a covariance matrix.
+  static constexpr bool isVolume = std::is_arithmetic< Argument >::value;
+  /// Number of convolved moments (1 for volumes, 1 + d + d(d+1)/2 for covariance matrices).
+  static constexpr Dimension nbMoments = isVolume ? 1 : 1 + Space::dimension + Space::dimension * ( Space::dimension + 1 ) / 2;
+
+  typedef ImplicitBall<Space> KernelSupport;
+  typedef GaussDigitizer< Space, KernelSupport > DigitalShapeKernel;
+  typedef RealFFT< Domain, double > FFT;
+  typedef double Scalar;
+
+  // ----------------------- Standard services ------------------------------
+public:
+
+  /**
+  * Default constructor. The object is invalid. The user needs to call
+  * setParams and attach.
+  *
+  * @param[in] fct the functor for transforming the volume or the
+  * covariance matrix into some quantity. If not precised, a default
+  * object is instantiated.
+  */
+  IntegralInvariantFFTEstimator( Functor fct = Functor() );
+
+  /**
+  * Constructor.
+  *
+  * @param[in] K the cellular grid space in which the shape is defined.
+  * @param[in] aPointPredicate the shape of interest. The alias can be secured
+  * if a some counted pointer is handed.
+  * @param[in] fct the functor for transforming the volume or the
+  * covariance matrix into some quantity. If not precised, a default
+  * object is instantiated.
+  */
+  IntegralInvariantFFTEstimator ( ConstAlias< KSpace > K,
+                                  ConstAlias< PointPredicate > aPointPredicate,
+                                  Functor fct = Functor() );
+
+  /**
+  * Clears the object. It is now invalid.
+  */
+  void clear();
+
+  // ----------------------- Interface --------------------------------------
+public:
+
+  /// @return the grid step.
+  Scalar h() const;
+
+  /**
+  * Attach a shape, defined as a functor spel -> boolean
+  *
+  * @param[in] K the cellular grid space in which the shape is defined.
+  * @param aPointPredicate the shape of interest. The alias can be secured
+  * if a some counted pointer is handed.
+  */
+  void attach( ConstAlias< KSpace > K,
+               ConstAlias<PointPredicate> aPointPredicate );
+
+  /**
+  * Set specific parameters: the radius of the ball.
+  *
+  * @param[in] dRadius the "digital" radius of the kernel (buy may be non integer).
+  */
+  void setParams( const double dRadius );
+
+  /**
+  * Model of CDigitalSurfaceLocalEstimator. Initialisation: computes
+  * the FFT convolutions and stores the moments at the inner and
+  * outer spels of the surfels of [itb,ite).
+  *
+  * @tparam SurfelConstIterator any model of forward readable iterator on Surfel.
+  * @param[in] _h grid size (must be >0).
+  * @param[in] itb iterator on the first surfel of the surface.
+  * @param[in] ite iterator after the last surfel of the surface.
+  */
+  template <typename SurfelConstIterator>
+  void init( const double _h, SurfelConstIterator itb, SurfelConstIterator ite );
+
+  /**
+  * -- Estimation --
+  *
+  * Returns the quantity at surfel *it.
+  *
+  * @tparam SurfelConstIterator type of Iterator on a Surfel
+  *
+  * @param[in] it iterator pointing on a surfel of the range given to init().
+  *
+  * @return quantity at surfel *it
+  */
+  template< typename SurfelConstIterator >
+  Quantity eval ( SurfelConstIterator it ) const;
+
+  /**
+  * -- Estimation --
+  *
+  * Returns the quantities for a range of surfels [itb,ite) on the
+  * OutputIterator (param).
+  *
+  * @tparam OutputIterator type of Iterator of an array of Quantity
+  * @tparam SurfelConstIterator type of Iterator on a Surfel
+  *
+  * @param[in] itb iterator defining the start of the range of surfels
+  * (surfels of the range given to init()).
+  *
+  * @param[in] ite iterator defining the end of the range of surfels.
+  *
+  * @param[in] result output iterator of results of the computation.
+  * @return the updated output iterator after all outputs.
+  */
+  template <typename OutputIterator, typename SurfelConstIterator>
+  OutputIterator eval( SurfelConstIterator itb,
+                       SurfelConstIterator ite,
+                       OutputIterator result ) const;
+
+  /**
+  * Rough estimation of the crossover between the FFT and the
+  * per-surfel convolver (see IntegralInvariantVolumeEstimator), based
+  * on the number of point operations of both approaches: FFTs on the
+  * padded domain versus convolver masks (about two kernel
+  * cross-sections per spel when surfels are ordered).
+  *
+  * @param[in] K the cellular grid space in which the shape is defined.
+  * @param[in] nbSurfels the number of surfels to evaluate.
+  * @param[in] dRadius the "digital" radius of the kernel.
+  * @return 'true' if the FFT approach is expected to be faster.
+  */
+  static bool isFasterThanConvolver( const KSpace & K,
+                                     std::size_t nbSurfels,
+                                     const double dRadius );
+
+  /**
+  * Writes/Displays the object on an output stream.
+  * @param out the output stream where the object is written.
+  */
+  void selfDisplay ( std::ostream & out ) const;
+
+  /**
+  * Checks the validity/consistency of the object.
+  * @return 'true' if the object is valid, 'false' otherwise.
+  */
+  bool isValid() const;
+
+  // ------------------------- Private Datas --------------------------------
+private:
+
+  Functor myFct;                  ///< The functor that transforms the volume or covariance matrix into a quantity.
+  CountedConstPtrOrConstPtr<KSpace> myKSpace;                 ///< The cellular grid space.
+  CountedConstPtrOrConstPtr<PointPredicate> myPointPredicate; ///< Smart pointer (if required) on a point predicate.
+  Point myLowerBound;             ///< Lower bound of the stored moments domain (one spel around the cellular grid space domain).
+  Point myExtent;                 ///< Extent of the stored moments domain.
+  std::vector< DGtal::uint32_t > mySlots; ///< Index of the stored moments of each point (noSlot if none).
+  std::vector< double > myMoments;        ///< Stored moments, nbMoments per slot.
+  Scalar myH;                     ///< precision of the grid
+  Scalar myRadius;                ///< "digital" radius of the kernel (buy may be non integer).
+
+  // ------------------------- Hidden services ------------------------------
+private:
+
+  /// @return the slot value of points without stored moments.
+  static DGtal::uint32_t noSlot();
+
+  /**
+  * @param[in] aPoint a point of the stored moments domain.
+  * @return the index of @a aPoint in mySlots.
+  */
+  std::size_t pointIndex( const Point & aPoint ) const;
+
+  /**
+  * @param[in] aMoment a moment index in [0,nbMoments).
+  * @param[in] aPoint a kernel point.
+  * @return the value of the moment kernel at @a aPoint.
+  */
+  static double momentWeight( Dimension aMoment, const Point & aPoint );
+
+  /**
+  * @param[in] aPoint a spel digital point whose moments are stored.
+  * @return the covariance matrix of the kernel centered on @a aPoint.
+  */
+  Argument covarianceMatrix( const Point & aPoint ) const;
+
+  /**
+  * @param[in] aSurfel a surfel of the range given to init().
+  * @return the functor argument (average of the inner and outer spel values).
+  */
+  Argument argument( const Surfel & aSurfel ) const;
+
+}; // end of class IntegralInvariantFFTEstimator
+
+  /**
+  * Overloads 'operator<<' for displaying objects of class 'IntegralInvariantFFTEstimator'.
+  * @param out the output stream where the object is written.
+  * @param object the object of class 'IntegralInvariantFFTEstimator' to write.
+  * @return the output stream after the writing.
+  */
+  template <typename TKSpace, typename TPointPredicate, typename TFunctor>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const IntegralInvariantFFTEstimator<TKSpace, TPointPredicate, TFunctor> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantFFTEstimator.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined IntegralInvariantFFTEstimator_h
+
+#undef IntegralInvariantFFTEstimator_RECURSES
+#endif // else defined(IntegralInvariantFFTEstimator_RECURSES)
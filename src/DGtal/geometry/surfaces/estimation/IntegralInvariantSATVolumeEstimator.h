@@ -0,0 +1,321 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file IntegralInvariantSATVolumeEstimator.h
+ *
+ * Header file for module IntegralInvariantSATVolumeEstimator.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(IntegralInvariantSATVolumeEstimator_RECURSES)
+#error Recursive header files inclusion detected in IntegralInvariantSATVolumeEstimator.h
+#else // defined(IntegralInvariantSATVolumeEstimator_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define IntegralInvariantSATVolumeEstimator_RECURSES
+
+#if !defined IntegralInvariantSATVolumeEstimator_h
+/** Prevents repeated inclusion of headers. */
+#define IntegralInvariantSATVolumeEstimator_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include <utility>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/CountedConstPtrOrConstPtr.h"
+#include "DGtal/kernel/CPointPredicate.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+#include "DGtal/topology/CCellularGridSpaceND.h"
+#include "DGtal/shapes/GaussDigitizer.h"
+#include "DGtal/shapes/implicit/ImplicitBall.h"
+#include "DGtal/geometry/surfaces/estimation/IIGeometricFunctors.h"
+//////////////////////////////////////////////////////////////////////////////
+
+
+namespace DGtal
+{
+
+/////////////////////////////////////////////////////////////////////////////
+// template class IntegralInvariantSATVolumeEstimator
+/**
+* Description of template class 'IntegralInvariantSATVolumeEstimator' <p>
+* \brief Aim: Integral Invariant volume estimator (see
+* IntegralInvariantVolumeEstimator) based on a summed volume table
+* of the shape.
+*
+* When attached to a shape, the estimator builds the summed volume
+* table (n-dimensional summed area table) of the shape over the
+* domain of the cellular grid space, i.e. the number of shape points
+* in any box is obtained with @f$ 2^d @f$ table lookups. At
+* initialization, the digital ball kernel is decomposed into a set of
+* boxes (runs along the first axis merged successively along the
+* other axes). The volume of the intersection between the shape and
+* the kernel centered on the inner and outer spels of a surfel is then
+* computed in O(number of boxes) whatever the surfel order, which is
+* @f$ O(r^{d-1}) @f$ instead of @f$ O(r^d) @f$ for large radii @a r
+* and unordered surfels.
+*
+* Results are the same as IntegralInvariantVolumeEstimator for the
+* same shape, kernel radius and grid step. The table costs one
+* predicate evaluation and one 32-bits counter per point of the
+* domain, hence this estimator is meant for dense shapes, like binary
+* images, whose domain has less than @f$ 2^{32} @f$ points.
+*
+* If DGtal has been built with OpenMP, random access surfel ranges
+* are evaluated in parallel.
+*
+* @tparam TKSpace a model of CCellularGridSpaceND, the cellular space
+* in which the shape is defined.
+*
+* @tparam TPointPredicate a model of concepts::CPointPredicate, a predicate
+* Point -> bool that defines a digital shape as a characteristic
+* function.
+*
+* @tparam TVolumeFunctor a model of functor Real -> Quantity, that
+* defines how the volume computed by the Integral Invariant estimator
+* is transformed into e.g. a curvature, etc. Models include
+* IIGeometricFunctors::IICurvatureFunctor,
+* IIGeometricFunctors::IIMeanCurvature3DFunctor.
+*
+* @see IntegralInvariantVolumeEstimator
+*/
+template <typename TKSpace, typename TPointPredicate, typename TVolumeFunctor>
+class IntegralInvariantSATVolumeEstimator
+{
+public:
+  typedef IntegralInvariantSATVolumeEstimator< TKSpace, TPointPredicate, TVolumeFunctor> Self;
+  typedef TKSpace KSpace;
+  typedef TPointPredicate PointPredicate;
+  typedef TVolumeFunctor VolumeFunctor;
+
+  BOOST_CONCEPT_ASSERT (( concepts::CCellularGridSpaceND< KSpace > ));
+  BOOST_CONCEPT_ASSERT (( concepts::CPointPredicate< PointPredicate > ));
+
+  typedef typename KSpace::Space Space;
+  typedef HyperRectDomain<Space> Domain;
+  typedef typename Space::Point Point;
+  typedef typename Space::RealPoint RealPoint;
+  typedef typename Space::Dimension Dimension;
+  typedef typename KSpace::Surfel Surfel;
+
+  /// The returned type of the estimator, depends on the functor
+  typedef typename VolumeFunctor::Quantity Quantity;
+  /// The type of the summed volume table counters.
+  typedef DGtal::uint32_t Count;
+  /// A box of the kernel decomposition (lower and upper bounds, relative to the kernel center).
+  typedef std::pair< Point, Point > Box;
+
+  typedef ImplicitBall<Space> KernelSupport;
+  typedef GaussDigitizer< Space, KernelSupport > DigitalShapeKernel;
+  typedef double Scalar;
+
+  // ----------------------- Standard services ------------------------------
+public:
+
+  /**
+  * Default constructor. The object is invalid. The user needs to call
+  * setParams and attach.
+  *
+  * @param[in] fct the functor for transforming the volume into
+  * some quantity. If not precised, a default object is instantiated.
+  */
+  IntegralInvariantSATVolumeEstimator( VolumeFunctor fct = VolumeFunctor() );
+
+  /**
+  * Constructor. Builds the summed volume table of the shape.
+  *
+  * @param[in] K the cellular grid space in which the shape is defined.
+  * @param[in] aPointPredicate the shape of interest. The alias can be secured
+  * if a some counted pointer is handed.
+  * @param[in] fct the functor for transforming the volume into
+  * some quantity. If not precised, a default object is instantiated.
+  */
+  IntegralInvariantSATVolumeEstimator ( ConstAlias< KSpace > K,
+                                        ConstAlias< PointPredicate > aPointPredicate,
+                                        VolumeFunctor fct = VolumeFunctor() );
+
+  /**
+  * Clears the object. It is now invalid.
+  */
+  void clear();
+
+  // ----------------------- Interface --------------------------------------
+public:
+
+  /// @return the grid step.
+  Scalar h() const;
+
+  /**
+  * Attach a shape, defined as a functor spel -> boolean, and builds
+  * its summed volume table.
+  *
+  * @param[in] K the cellular grid space in which the shape is defined.
+  * @param aPointPredicate the shape of interest. The alias can be secured
+  * if a some counted pointer is handed.
+  */
+  void attach( ConstAlias< KSpace > K,
+               ConstAlias<PointPredicate> aPointPredicate );
+
+  /**
+  * Set specific parameters: the radius of the ball.
+  *
+  * @param[in] dRadius the "digital" radius of the kernel (buy may be non integer).
+  */
+  void setParams( const double dRadius );
+
+  /**
+  * Model of CDigitalSurfaceLocalEstimator. Initialisation: digitizes
+  * the kernel and computes its box decomposition.
+  *
+  * @tparam SurfelConstIterator any model of forward readable iterator on Surfel.
+  * @param[in] _h grid size (must be >0).
+  * @param[in] itb iterator on the first surfel of the surface.
+  * @param[in] ite iterator after the last surfel of the surface.
+  */
+  template <typename SurfelConstIterator>
+  void init( const double _h, SurfelConstIterator itb, SurfelConstIterator ite );
+
+  /**
+  * -- Estimation --
+  *
+  * Compute the integral invariant volume at surfel *it of
+  * a shape, then apply the VolumeFunctor to extract some
+  * geometric information.
+  *
+  * @tparam SurfelConstIterator type of Iterator on a Surfel
+  *
+  * @param[in] it iterator pointing on the surfel of the shape where
+  * we wish to evaluate some geometric information.
+  *
+  * @return quantity at surfel *it
+  */
+  template< typename SurfelConstIterator >
+  Quantity eval ( SurfelConstIterator it ) const;
+
+  /**
+  * -- Estimation --
+  *
+  * Compute the integral invariant volume for a range of
+  * surfels [itb,ite) on a shape, then apply the
+  * VolumeFunctor to extract some geometric information.
+  * Return the result on an OutputIterator (param).
+  *
+  * @tparam OutputIterator type of Iterator of an array of Quantity
+  * @tparam SurfelConstIterator type of Iterator on a Surfel
+  *
+  * @param[in] itb iterator defining the start of the range of surfels
+  * where we wish to compute some geometric information.
+  *
+  * @param[in] ite iterator defining the end of the range of surfels
+  * where we wish to compute some geometric information.
+  *
+  * @param[in] result output iterator of results of the computation.
+  * @return the updated output iterator after all outputs.
+  */
+  template <typename OutputIterator, typename SurfelConstIterator>
+  OutputIterator eval( SurfelConstIterator itb,
+                       SurfelConstIterator ite,
+                       OutputIterator result ) const;
+
+  /**
+  * @param[in] aCenter any point.
+  * @return the number of shape points in the digital kernel centered
+  * on @a aCenter.
+  */
+  Count volume( const Point & aCenter ) const;
+
+  /**
+  * @param[in] aLower the lower bound of a box.
+  * @param[in] anUpper the upper bound of a box.
+  * @return the number of shape points in the box (points outside the
+  * domain of the cellular grid space are not counted).
+  */
+  Count boxVolume( const Point & aLower, const Point & anUpper ) const;
+
+  /// @return the box decomposition of the digital kernel.
+  const std::vector< Box > & kernelBoxes() const;
+
+  /**
+  * Writes/Displays the object on an output stream.
+  * @param out the output stream where the object is written.
+  */
+  void selfDisplay ( std::ostream & out ) const;
+
+  /**
+  * Checks the validity/consistency of the object.
+  * @return 'true' if the object is valid, 'false' otherwise.
+  */
+  bool isValid() const;
+
+  // ------------------------- Private Datas --------------------------------
+private:
+
+  VolumeFunctor myFct;            ///< The volume functor that transforms the volume into a quantity.
+  CountedConstPtrOrConstPtr<KSpace> myKSpace;                 ///< The cellular grid space.
+  CountedConstPtrOrConstPtr<PointPredicate> myPointPredicate; ///< Smart pointer (if required) on a point predicate.
+  Point myLowerBound;             ///< Lower bound of the summed volume table domain.
+  Point myUpperBound;             ///< Upper bound of the summed volume table domain.
+  Point myTableExtent;            ///< Extent of the table (domain extent + 1 along each axis).
+  std::vector< Count > myTable;   ///< Summed volume table.
+  std::vector< Box > myBoxes;     ///< Box decomposition of the digital kernel.
+  Scalar myH;                     ///< precision of the grid
+  Scalar myRadius;                ///< "digital" radius of the kernel (buy may be non integer).
+
+  // ------------------------- Hidden services ------------------------------
+private:
+
+  /// Builds the summed volume table of the attached shape.
+  void computeTable();
+
+  /**
+  * @param[in] aCorner a point of the table domain, i.e. between
+  * Point::zero and myTableExtent - Point::diagonal(1).
+  * @return the index of @a aCorner in myTable.
+  */
+  std::size_t tableIndex( const Point & aCorner ) const;
+
+}; // end of class IntegralInvariantSATVolumeEstimator
+
+  /**
+  * Overloads 'operator<<' for displaying objects of class 'IntegralInvariantSATVolumeEstimator'.
+  * @param out the output stream where the object is written.
+  * @param object the object of class 'IntegralInvariantSATVolumeEstimator' to write.
+  * @return the output stream after the writing.
+  */
+  template <typename TKSpace, typename TPointPredicate, typename TVolumeFunctor>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const IntegralInvariantSATVolumeEstimator<TKSpace, TPointPredicate, TVolumeFunctor> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantSATVolumeEstimator.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined IntegralInvariantSATVolumeEstimator_h
+
+#undef IntegralInvariantSATVolumeEstimator_RECURSES
+#endif // else defined(IntegralInvariantSATVolumeEstimator_RECURSES)
@@ -282,6 +282,11 @@ public:
   *
   * @param[in] result output iterator of results of the computation.
   * @return the updated output iterator after all outputs.
+  *
+  * @note If DGtal is built with OpenMP and SurfelConstIterator is
+  * a random access iterator, the range is split into contiguous
+  * chunks evaluated in parallel (each chunk keeps the shifted
+  * kernels optimization). Results are written in the range order.
   */
   template <typename OutputIterator, typename SurfelConstIterator>
   OutputIterator eval( SurfelConstIterator itb,
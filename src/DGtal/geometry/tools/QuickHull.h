@@ -40,11 +40,15 @@
 
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <queue>
 #include <set>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 #include "DGtal/base/Common.h"
 #include "DGtal/base/Clock.h"
 #include "DGtal/geometry/tools/QuickHullKernels.h"
@@ -134,6 +138,12 @@ namespace DGtal
   /// @note However this implementation is not tailored for incremental
   /// dynamic convex hull computations.
   ///
+  /// @note For very large point clouds, points may be streamed from
+  /// any range of iterators (see setInput), the Akl-Toussaint
+  /// heuristic may discard most interior points before the hull
+  /// computation (see filterInput), and the initial partition of points
+  /// to facets is done in parallel when DGtal is built with OpenMP.
+  ///
   /// @tparam TKernel any type of QuickHull kernel, like ConvexHullIntegralKernel.
   template < typename TKernel >
   struct QuickHull
@@ -223,7 +233,7 @@ namespace DGtal
       }
       Size variableMemory() const
       {
-        Size M;
+        Size M = 0;
         M += neighbors.capacity()   * sizeof( Index );
         M += outside_set.capacity() * sizeof( Index );
         M += on_set.capacity()      * sizeof( Index );
@@ -257,7 +267,8 @@ namespace DGtal
     /// @param[in] K a kernel for computing facet geometries.
     /// @param[in] dbg the trace level, from 0 (no) to 3 (very verbose).
     QuickHull( const Kernel& K = Kernel(), int dbg = 0 )
-      : kernel( K ), debug_level( dbg ), myStatus( Status::Uninitialized )
+      : kernel( K ), debug_level( dbg ), nb_deleted_facets( 0 ),
+        myStatus( Status::Uninitialized )
     {}
 
     /// @return the current status of this object, in Uninitialized,
@@ -277,6 +288,8 @@ namespace DGtal
       assignment.clear();
       facets.clear();
       deleted_facets.clear();
+      nb_deleted_facets = 0;
+      facet_marks.clear();
       p2v.clear();
       v2p.clear();
       timings.clear();
@@ -304,9 +317,11 @@ namespace DGtal
       M += sizeof( std::vector< Facet > )
         + facets.capacity() * sizeof( Facet );
       for ( const auto& f : facets ) M += f.variableMemory();
-      // std::set< Index > deleted_facets;
-      M += sizeof( std::set< Index > )
-        + deleted_facets.size() * ( sizeof( Index ) + 2*sizeof(Index*) );
+      // std::vector< bool > deleted_facets;
+      M += sizeof( std::vector< bool > ) + deleted_facets.capacity() / 8;
+      // IndexRange facet_marks;
+      M += sizeof( std::vector< Index > )
+        + facet_marks.capacity() * sizeof( Index );
       // IndexRange p2v;
       M += sizeof( std::vector< Index > )
         + p2v.capacity() * sizeof( Index );
@@ -397,6 +412,133 @@ namespace DGtal
       return true;
     }
 
+    /// Sets the input data for the QuickHull convex hull algorithm,
+    /// which is given as a range of iterators. Points are converted
+    /// on the fly, so the input range is never copied before
+    /// conversion. It is thus well suited to huge implicit ranges,
+    /// like the points of a digital set or of a domain.
+    ///
+    /// @tparam InputIterator any model of input iterator whose value
+    /// type is a point that is convertible to Point datatype.
+    ///
+    /// @param[in] itb an iterator on the first input point.
+    /// @param[in] ite an iterator after the last input point.
+    ///
+    /// @param[in] remove_duplicates should be set to 'true' if the
+    /// input data has duplicates.
+    ///
+    /// @return 'true' if the object is successfully initialized,
+    /// status must be Status::InputInitialized, 'false' otherwise.
+    template < typename InputIterator >
+    bool setInput( InputIterator itb, InputIterator ite,
+                   bool remove_duplicates = true )
+    {
+      Clock tic;
+      tic.startClock();
+      clear();
+      timings.clear();
+      kernel.makeInput( points, input2comp,  comp2input,
+                        itb, ite, remove_duplicates );
+      timings.push_back( tic.stopClock() );
+      if ( points.size() <= dimension ) {
+        myStatus = Status::NotFullDimensional;
+        return false;
+      }
+      myStatus = Status::InputInitialized;
+      return true;
+    }
+
+    /// Removes from the input points the ones that are strictly
+    /// inside the convex hull of a few extremal points (Akl-Toussaint
+    /// heuristic). The extremal points are the ones that maximize or
+    /// minimize each coordinate and each sum of coordinates with
+    /// signs \f$ \pm x_0 \pm \ldots \pm x_{d-1} \f$. Removed points
+    /// cannot be on the convex hull, hence the hull is the same,
+    /// but it is computed faster and with less memory when the input
+    /// points are dense, like lattice points in a convex region.
+    ///
+    /// @pre status() must be Status::InputInitialized
+    ///
+    /// @return the number of removed points.
+    ///
+    /// @note Afterwards, `comp2input` still gives the input index of
+    /// each remaining point, while `input2comp` is UNASSIGNED for
+    /// each removed input point.
+    Size filterInput()
+    {
+      if ( status() != Status::InputInitialized ) return 0;
+      Clock tic;
+      tic.startClock();
+      // Extremal points along the 2d axis directions and the 2^d diagonal ones.
+      const Size nbd  = 2 * dimension + ( Size( 1 ) << dimension );
+      IndexRange extremes( nbd, 0 );
+      std::vector< InternalScalar > values( nbd );
+      const auto projections = [&] ( const Point& p, std::vector< InternalScalar >& v )
+      {
+        for ( Dimension k = 0; k < dimension; k++ ) {
+          v[ 2*k ]   =  InternalScalar( p[ k ] );
+          v[ 2*k+1 ] = -InternalScalar( p[ k ] );
+        }
+        for ( Size s = 0; s < ( Size( 1 ) << dimension ); s++ ) {
+          InternalScalar x = InternalScalar( 0 );
+          for ( Dimension k = 0; k < dimension; k++ )
+            x += ( s & ( Size( 1 ) << k ) )
+              ? -InternalScalar( p[ k ] ) : InternalScalar( p[ k ] );
+          v[ 2*dimension+s ] = x;
+        }
+      };
+      std::vector< InternalScalar > v( nbd );
+      projections( points[ 0 ], values );
+      for ( Index i = 1; i < points.size(); i++ ) {
+        projections( points[ i ], v );
+        for ( Index j = 0; j < nbd; j++ )
+          if ( v[ j ] > values[ j ] ) { values[ j ] = v[ j ]; extremes[ j ] = i; }
+      }
+      std::sort( extremes.begin(), extremes.end() );
+      extremes.erase( std::unique( extremes.begin(), extremes.end() ), extremes.end() );
+      // Convex hull of extremal points, with the same kernel.
+      QuickHull filter( kernel );
+      for ( auto i : extremes ) filter.points.push_back( points[ i ] );
+      filter.myStatus = filter.points.size() > dimension
+        ? Status::InputInitialized : Status::NotFullDimensional;
+      if ( ! filter.computeConvexHull( Status::FacetsCompleted ) ) {
+        timings[ 0 ] += tic.stopClock();
+        return 0;
+      }
+      // Marks points strictly inside the hull of extremal points.
+      std::vector< char > inside( points.size() );
+      const int nb = points.size();
+#ifdef WITH_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for ( int i = 0; i < nb; i++ ) //MSVC requires signed type for openmp
+        {
+          bool in = true;
+          for ( Index f = 0; in && f < filter.facets.size(); f++ )
+            in = kernel.height( filter.facets[ f ].H, points[ i ] )
+              < InternalScalar( 0 );
+          inside[ i ] = in ? 1 : 0;
+        }
+      // Compacts points and updates the mappings.
+      IndexRange renumbering( points.size(), UNASSIGNED );
+      Index j = 0;
+      for ( Index i = 0; i < points.size(); i++ )
+        if ( ! inside[ i ] ) {
+          renumbering[ i ] = j;
+          points    [ j ] = points    [ i ];
+          comp2input[ j ] = comp2input[ i ];
+          j++;
+        }
+      const Size nb_removed = points.size() - j;
+      points.resize( j );
+      points.shrink_to_fit();
+      comp2input.resize( j );
+      comp2input.shrink_to_fit();
+      for ( auto& c : input2comp ) c = renumbering[ c ];
+      timings[ 0 ] += tic.stopClock();
+      return nb_removed;
+    }
+
     /// Sets the initial full dimensional simplex
     ///
     /// @pre status() must be Status::InputInitialized
@@ -534,7 +676,7 @@ namespace DGtal
       cleanFacets();
       if ( debug_level >= 2 ) {
         trace.info() << ".... #facets=" << facets.size()
-                  << " #deleted=" << deleted_facets.size() << std::endl;
+                  << " #deleted=" << nb_deleted_facets << std::endl;
       }
       myStatus = Status::FacetsCompleted;
       return true;
@@ -745,7 +887,7 @@ namespace DGtal
       Size   nb = 0;
       Size nbok = 0;
       for ( Index f = 0; f < facets.size(); ++f )
-        if ( deleted_facets.count( f ) == 0 ) {
+        if ( ! deleted_facets[ f ] ) {
           bool ok = checkFacet( f );
           nbok   += ok ? 1 : 0;
           nb     += 1;
@@ -766,7 +908,7 @@ namespace DGtal
       for ( auto v : processed_points ) {
         bool ok = true;
         for ( Index f = 0; f < facets.size(); ++f )
-          if ( deleted_facets.count( f ) == 0 ) {
+          if ( ! deleted_facets[ f ] ) {
             if ( above( facets[ f ], points[ v ] ) ) {
               ok = false;
               trace.error() << "- bad vertex " << v << " " << points[ v ]
@@ -812,8 +954,13 @@ namespace DGtal
     std::vector< Index > assignment;
     /// the current set of facets.
     std::vector< Facet > facets;
-    /// set of deleted facets
-    std::set< Index > deleted_facets;
+    /// for each facet, 'true' iff it is deleted.
+    std::vector< bool > deleted_facets;
+    /// the number of deleted facets.
+    Size nb_deleted_facets;
+    /// for each facet, the last point whose visible facets were
+    /// extracted while this facet was marked (or UNASSIGNED).
+    IndexRange facet_marks;
     /// point index -> vertex index (or UNASSIGNED)
     IndexRange p2v;
     /// vertex index -> point index
@@ -872,17 +1019,19 @@ namespace DGtal
     /// deleted_facets.
     void cleanFacets()
     {
-      if ( deleted_facets.empty() ) return;
+      if ( nb_deleted_facets == 0 ) return;
       IndexRange renumbering( facets.size() );
       Index i = 0;
       Index j = 0;
       for ( auto& l : renumbering ) {
-        if ( ! deleted_facets.count( j ) ) l = i++;
+        if ( ! deleted_facets[ j ] ) l = i++;
         else l = UNASSIGNED;
         j++;
       }
-      const Index nf = facets.size() - deleted_facets.size();
-      deleted_facets.clear();
+      const Index nf = facets.size() - nb_deleted_facets;
+      deleted_facets.assign( nf, false );
+      facet_marks.assign( nf, UNASSIGNED );
+      nb_deleted_facets = 0;
       for ( Index f = 0; f < facets.size(); f++ )
         if ( ( renumbering[ f ] != UNASSIGNED ) && ( f != renumbering[ f ] ) )
           facets[ renumbering[ f ] ] = facets[ f ];
@@ -973,7 +1122,7 @@ namespace DGtal
       Index F = Q.front();
       Q.pop();
       // If F is already deleted, proceed to next in queue.
-      if ( deleted_facets.count( F ) ) return true;
+      if ( deleted_facets[ F ] ) return true;
       // Take car of current facet.
       const Facet& facet = facets[ F ];
       if ( debug_level >= 3 ) {
@@ -981,7 +1130,7 @@ namespace DGtal
         trace.info() << "---- ACTIVE FACETS---------------------------" << std::endl;
         bool ok = true;
         for ( Index i = 0; i < facets.size(); i++ )
-          if ( ! deleted_facets.count( i ) ) {
+          if ( ! deleted_facets[ i ] ) {
             trace.info() << "- facet " << i << " ";
             facets[ i ].display( trace.info() );
             ok = ok && checkFacet( i );
@@ -1008,24 +1157,25 @@ namespace DGtal
         }
       }
       const Point& p = points[ furthest_v ];
-      // Extracts Visible facets V and Horizon Ridges H
+      // Extracts Visible facets V and Horizon Ridges H. Marked facets
+      // (are in E or were in E) are the ones with facet_marks equal
+      // to furthest_v.
       std::vector< Index > V;   // visible facets
-      std::set< Index >    M;   // marked facets (are in E or were in E)
       std::queue< Index >  E;   // queue to extract visible facets
       std::vector< Ridge > H;   // visible facets
       E.push  ( F );
-      M.insert( F );
+      facet_marks[ F ] = furthest_v;
       while ( ! E.empty() ) {
         Index G = E.front(); E.pop();
         V.push_back( G );
         for ( auto& N : facets[ G ].neighbors ) {
           if ( aboveOrOn( facets[ N ], p ) ) {
-            if ( M.count( N ) ) continue;
+            if ( facet_marks[ N ] == furthest_v ) continue;
             E.push( N );
           } else {
             H.push_back( { G, N } );
           }
-          M.insert( N );
+          facet_marks[ N ] = furthest_v;
         }
       } // while ( ! E.empty() ) 
       if ( debug_level >= 1 ) {
@@ -1138,7 +1288,7 @@ namespace DGtal
         Q.push( new_facets[ i ] );
       if ( debug_level >= 1 ) {
         trace.info() << "#facets=" << facets.size()
-                  << " #deleted=" << deleted_facets.size() << std::endl;
+                  << " #deleted=" << nb_deleted_facets << std::endl;
       }
 
       // Checks that everything is ok.
@@ -1210,6 +1360,8 @@ namespace DGtal
       // SLightly faster to postpone deletion of intermediate facets.
       const Index f = facets.size();
       facets.push_back( Facet() );
+      deleted_facets.push_back( false );
+      facet_marks.push_back( UNASSIGNED );
       return f;
     }
 
@@ -1219,7 +1371,8 @@ namespace DGtal
     {
       for ( auto n : facets[ f ].neighbors )
         facets[ n ].subNeighbor( f );
-      deleted_facets.insert( f );
+      deleted_facets[ f ] = true;
+      nb_deleted_facets  += 1;
       facets[ f ].clear();
     }
 
@@ -1253,11 +1406,13 @@ namespace DGtal
       Facet& f2 = facets[ if2 ];
       std::copy( f2.outside_set.cbegin(), f2.outside_set.cend(),
                  std::back_inserter( f1.outside_set ) );
-      IndexRange merge_idx;
-      std::set_union( f1.on_set.cbegin(), f1.on_set.cend(),
-                      f2.on_set.cbegin(), f2.on_set.cend(),
-                      std::back_inserter( merge_idx ) );
-      f1.on_set.swap( merge_idx );
+      // Merges the two sorted on sets in place.
+      const auto n1 = f1.on_set.size();
+      f1.on_set.insert( f1.on_set.end(), f2.on_set.cbegin(), f2.on_set.cend() );
+      std::inplace_merge( f1.on_set.begin(), f1.on_set.begin() + n1,
+                          f1.on_set.end() );
+      f1.on_set.erase( std::unique( f1.on_set.begin(), f1.on_set.end() ),
+                       f1.on_set.end() );
       for ( auto && nf2 : f2.neighbors ) {
         if ( nf2 == if1 ) continue;
         facets[ nf2 ].subNeighbor( if2 );
@@ -1455,7 +1610,9 @@ namespace DGtal
     {
       assignment = std::vector< Index >( points.size(), UNASSIGNED );
       facets.resize( dimension + 1 );
-      deleted_facets.clear();
+      deleted_facets.assign( facets.size(), false );
+      facet_marks.assign( facets.size(), UNASSIGNED );
+      nb_deleted_facets = 0;
       for ( Index j = 0; j < full_simplex.size(); ++j )
         {
           IndexRange lsimplex( dimension );
@@ -1472,20 +1629,23 @@ namespace DGtal
           for ( auto&& v : isimplex ) facets[ j ].on_set.push_back( v );
           std::sort( facets[ j ].on_set.begin(), facets[ j ].on_set.end() );
         }
-      // List of unassigned vertices
-      for ( Index fi = 0; fi < facets.size(); ++fi ) {
-        Facet& f = facets[ fi ];
-        for ( Index v = 0; v < points.size(); v++ )
-          {
-            if ( assignment[ v ] == UNASSIGNED && above( f, points[ v ] ) ) {
-              f.outside_set.push_back( v );
-              assignment[ v ] = fi;
-            } 
+      // Assigns each point to the first facet it is above (in parallel),
+      // then builds outside sets and the list of unassigned vertices.
+      const int nb = points.size();
+#ifdef WITH_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for ( int v = 0; v < nb; v++ ) //MSVC requires signed type for openmp
+        for ( Index fi = 0; fi < facets.size(); ++fi )
+          if ( above( facets[ fi ], points[ v ] ) ) {
+            assignment[ v ] = fi;
+            break;
           }
-      }
       for ( Index v = 0; v < points.size(); v++ )
         if ( assignment[ v ] == UNASSIGNED )
           processed_points.push_back( v );
+        else
+          facets[ assignment[ v ] ].outside_set.push_back( v );
       
       // Display some information
       if ( debug_level >= 2 ) {
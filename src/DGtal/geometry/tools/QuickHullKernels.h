@@ -41,6 +41,7 @@
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 #include <array>
@@ -121,9 +122,9 @@ namespace DGtal
       }
       if ( ! remove_duplicates ) {
         output_values.swap( input );
-        input2output.resize( input.size() );
-        output2input.resize( input.size() );
-        for ( Size i = 0; i < input.size(); ++i )
+        input2output.resize( output_values.size() );
+        output2input.resize( output_values.size() );
+        for ( Size i = 0; i < output_values.size(); ++i )
           input2output[ i ] = output2input[ i ] = i;
       }
       else {
@@ -455,6 +456,34 @@ namespace DGtal
                     const std::vector< InputPoint >& input_points,
                     bool remove_duplicates )
     {
+      makeInput( processed_points, input2comp, comp2input,
+                 input_points.cbegin(), input_points.cend(),
+                 remove_duplicates );
+    }
+
+    /// Same as above, but the input points are given as a range of
+    /// iterators, which is traversed only once.
+    ///
+    /// @tparam InputIterator any model of input iterator on points
+    /// whose components are convertible to Scalar.
+    ///
+    /// @param[out] processed_points the range of points prepared for
+    /// a process by QuickHull.
+    /// @param[out] input2comp the surjective mapping between the input
+    /// range and the \a processed_points range used for computation.
+    /// @param[out] comp2input the injective mapping between the \a
+    /// processed_points range used for computation and the input range.
+    /// @param[in] itb an iterator on the first input point.
+    /// @param[in] ite an iterator after the last input point.
+    /// @param[in] remove_duplicates when 'true', this method removes possible
+    /// duplicates in the input range.
+    template < typename InputIterator >
+    void makeInput( std::vector< CoordinatePoint >& processed_points,
+                    IndexRange& input2comp, IndexRange& comp2input,
+                    InputIterator itb, InputIterator ite,
+                    bool remove_duplicates )
+    {
+      typedef typename std::iterator_traits< InputIterator >::value_type InputPoint;
       const auto F = [&] ( InputPoint input ) -> CoordinatePoint
       {
         CoordinatePoint p;
@@ -463,8 +492,7 @@ namespace DGtal
         return p;
       };
       DGtal::detail::transform( processed_points, input2comp, comp2input,
-                                input_points.cbegin(), input_points.cend(),
-                                F, remove_duplicates );
+                                itb, ite, F, remove_duplicates );
     }
 
     /// @tparam OutputPoint a model of point such that processing type
@@ -590,6 +618,34 @@ namespace DGtal
                     const std::vector< InputPoint >& input_points,
                     bool remove_duplicates )
     {
+      makeInput( processed_points, input2comp, comp2input,
+                 input_points.cbegin(), input_points.cend(),
+                 remove_duplicates );
+    }
+
+    /// Same as above, but the input points are given as a range of
+    /// iterators, which is traversed only once.
+    ///
+    /// @tparam InputIterator any model of input iterator on points
+    /// whose components are convertible to Scalar.
+    ///
+    /// @param[out] processed_points the range of points prepared for
+    /// a process by QuickHull.
+    /// @param[out] input2comp the surjective mapping between the input
+    /// range and the \a processed_points range used for computation.
+    /// @param[out] comp2input the injective mapping between the \a
+    /// processed_points range used for computation and the input range.
+    /// @param[in] itb an iterator on the first input point.
+    /// @param[in] ite an iterator after the last input point.
+    /// @param[in] remove_duplicates when 'true', this method removes possible
+    /// duplicates in the input range.
+    template < typename InputIterator >
+    void makeInput( std::vector< CoordinatePoint >& processed_points,
+                    IndexRange& input2comp, IndexRange& comp2input,
+                    InputIterator itb, InputIterator ite,
+                    bool remove_duplicates )
+    {
+      typedef typename std::iterator_traits< InputIterator >::value_type InputPoint;
       const auto F = [&] ( InputPoint input ) -> CoordinatePoint
         {
           CoordinatePoint p;
@@ -603,8 +659,7 @@ namespace DGtal
           return p;
         };
       DGtal::detail::transform( processed_points, input2comp, comp2input,
-                                input_points.cbegin(), input_points.cend(),
-                                F, remove_duplicates );
+                                itb, ite, F, remove_duplicates );
     }
 
     /// @tparam OutputPoint a model of point such that processing type
@@ -749,6 +804,34 @@ namespace DGtal
                     const std::vector< InputPoint >& input_points,
                     bool remove_duplicates )
     {
+      makeInput( processed_points, input2comp, comp2input,
+                 input_points.cbegin(), input_points.cend(),
+                 remove_duplicates );
+    }
+
+    /// Same as above, but the input points are given as a range of
+    /// iterators, which is traversed only once.
+    ///
+    /// @tparam InputIterator any model of input iterator on points
+    /// whose components are convertible to Scalar.
+    ///
+    /// @param[out] processed_points the range of points prepared for
+    /// a process by QuickHull.
+    /// @param[out] input2comp the surjective mapping between the input
+    /// range and the \a processed_points range used for computation.
+    /// @param[out] comp2input the injective mapping between the \a
+    /// processed_points range used for computation and the input range.
+    /// @param[in] itb an iterator on the first input point.
+    /// @param[in] ite an iterator after the last input point.
+    /// @param[in] remove_duplicates when 'true', this method removes possible
+    /// duplicates in the input range.
+    template < typename InputIterator >
+    void makeInput( std::vector< CoordinatePoint >& processed_points,
+                    IndexRange& input2comp, IndexRange& comp2input,
+                    InputIterator itb, InputIterator ite,
+                    bool remove_duplicates )
+    {
+      typedef typename std::iterator_traits< InputIterator >::value_type InputPoint;
       const auto F = [&] ( InputPoint input ) -> CoordinatePoint
         {
           CoordinatePoint p;
@@ -757,8 +840,7 @@ namespace DGtal
           return p;
         };
       DGtal::detail::transform( processed_points, input2comp, comp2input,
-                                input_points.cbegin(), input_points.cend(),
-                                F, remove_duplicates );
+                                itb, ite, F, remove_duplicates );
     }
 
     /// Converts an integral point (as represented internally for
@@ -925,6 +1007,34 @@ namespace DGtal
                     const std::vector< InputPoint >& input_points,
                     bool remove_duplicates )
     {
+      makeInput( processed_points, input2comp, comp2input,
+                 input_points.cbegin(), input_points.cend(),
+                 remove_duplicates );
+    }
+
+    /// Same as above, but the input points are given as a range of
+    /// iterators, which is traversed only once.
+    ///
+    /// @tparam InputIterator any model of input iterator on points
+    /// whose components are convertible to Scalar.
+    ///
+    /// @param[out] processed_points the range of points prepared for
+    /// a process by QuickHull.
+    /// @param[out] input2comp the surjective mapping between the input
+    /// range and the \a processed_points range used for computation.
+    /// @param[out] comp2input the injective mapping between the \a
+    /// processed_points range used for computation and the input range.
+    /// @param[in] itb an iterator on the first input point.
+    /// @param[in] ite an iterator after the last input point.
+    /// @param[in] remove_duplicates when 'true', this method removes possible
+    /// duplicates in the input range.
+    template < typename InputIterator >
+    void makeInput( std::vector< CoordinatePoint >& processed_points,
+                    IndexRange& input2comp, IndexRange& comp2input,
+                    InputIterator itb, InputIterator ite,
+                    bool remove_duplicates )
+    {
+      typedef typename std::iterator_traits< InputIterator >::value_type InputPoint;
       const auto F = [&] ( InputPoint input ) -> CoordinatePoint
         {
           CoordinatePoint p;
@@ -939,8 +1049,7 @@ namespace DGtal
           return p;
         };
       DGtal::detail::transform( processed_points, input2comp, comp2input,
-                                input_points.cbegin(), input_points.cend(),
-                                F, remove_duplicates );
+                                itb, ite, F, remove_duplicates );
     }
 
     /// Converts an integral point (as represented internally for
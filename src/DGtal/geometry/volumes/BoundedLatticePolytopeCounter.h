@@ -42,7 +42,9 @@
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
 #include <iostream>
+#include <array>
 #include <map>
+#include <vector>
 #include "DGtal/kernel/IntegralIntervals.h"
 #include "DGtal/geometry/volumes/BoundedLatticePolytope.h"
 //////////////////////////////////////////////////////////////////////////////
@@ -57,6 +59,23 @@ namespace DGtal
      \brief Aim: Useful to compute quickly the lattice points within a
      polytope, i.e. a convex polyhedron.
 
+     The lattice points are processed row by row along a given axis:
+     for each point of the bounding box projected along this axis,
+     the lattice points of the row within the polytope form an
+     interval, which is computed from all the half-spaces at once.
+     The coefficients of the half-spaces are copied at initialization
+     in one contiguous array, and their closed constraints
+     are turned into strict ones (\f$ a \cdot x \le b \f$ becomes
+     \f$ a \cdot x < b+1 \f$), so that the loop over half-spaces
+     has the same simple body for every half-space.
+
+     The rows may be streamed to a visitor with visitAlongAxis and
+     visitInteriorAlongAxis, which do not allocate any memory. Counting
+     is parallelized over rows (with OpenMP) for big polytopes.
+
+     @note The half-spaces of the polytope are copied by init. If the
+     polytope is modified afterwards, init must be called again.
+
      It is a model of boost::CopyConstructible,
      boost::DefaultConstructible, boost::Assignable. 
 
@@ -101,6 +120,35 @@ namespace DGtal
     /// @param ptrP any pointer on a polytope or nullptr.
     void init( const Polytope* ptrP );
 
+    /// Calls `visitor( p, I )` for each non empty row of lattice
+    /// points within the current polytope along axis \a a, where \a
+    /// p is the point of the row whose \a a-th coordinate is the one
+    /// of lowerBound(), and `I=[b,e)` is the interval of the \a a-th
+    /// coordinates of the lattice points of the row.
+    ///
+    /// @tparam IntervalVisitor the type of a function or functor
+    /// taking a Point and an Interval.
+    ///
+    /// @param visitor the function called for each row.
+    /// @param a any axis between 0 (included) and `dimension` (excluded).
+    ///
+    /// @note Rows are visited in the order of the projected bounding
+    /// box (first coordinate first), and no memory is allocated.
+    template < typename IntervalVisitor >
+    void visitAlongAxis( IntervalVisitor&& visitor, Dimension a ) const;
+
+    /// Calls `visitor( p, I )` for each non empty row of lattice
+    /// points strictly inside the current polytope along axis \a a,
+    /// as visitAlongAxis.
+    ///
+    /// @tparam IntervalVisitor the type of a function or functor
+    /// taking a Point and an Interval.
+    ///
+    /// @param visitor the function called for each row.
+    /// @param a any axis between 0 (included) and `dimension` (excluded).
+    template < typename IntervalVisitor >
+    void visitInteriorAlongAxis( IntervalVisitor&& visitor, Dimension a ) const;
+
     /// Computes the intersection of the lattice points of the
     /// infinite line going through point \a p along axis \a a and the
     /// current polytope, returned as an interval `[b,e)`, where `b`is
@@ -137,6 +185,9 @@ namespace DGtal
     /// is the one that minimizes the projected area of the polytope
     /// along this axis.
     /// @see longestAxis
+    ///
+    /// @note Rows are processed in parallel when OpenMP is available
+    /// and the polytope is big.
     Integer countAlongAxis( Dimension a ) const;
     
     /// @param a any axis with 0 <= a < d, where d is the dimension of the space.
@@ -147,6 +198,9 @@ namespace DGtal
     /// is the one that minimizes the projected area of the polytope
     /// along this axis.
     /// @see longestAxis
+    ///
+    /// @note Rows are processed in parallel when OpenMP is available
+    /// and the polytope is big.
     Integer countInteriorAlongAxis( Dimension a ) const;
 
     /// @param[out] pts the range of lattice points that are inside this polytope.
@@ -206,6 +260,44 @@ namespace DGtal
     Point myLower;
     /// The upper point of the tight bounding box to the associated polytope. 
     Point myUpper;
+    /// The coefficients of the half-spaces, half-space by half-space:
+    /// the \a j-th coefficient of the \a k-th half-space is at
+    /// `k*dimension+j`.
+    std::vector< Integer > myCoefs;
+    /// The bounds of the half-spaces as strict inequalities, for interior points.
+    std::vector< Integer > myInteriorB;
+    /// The bounds of the half-spaces as strict inequalities, closed
+    /// half-spaces being enlarged by one.
+    std::vector< Integer > myClosedB;
+
+    // --------------------------- internals -----------------------------------
+  protected:
+
+    /// Computes the interval of intersection of the row going
+    /// through \a p along axis \a a with the half-spaces of indices
+    /// \a k0 and more, seen as strict inequalities with bounds \a B.
+    ///
+    /// @param p any point with the current domain
+    /// @param a any axis between 0 (included) and `dimension` (excluded).
+    /// @param k0 the index of the first half-space.
+    /// @param B either myInteriorB or myClosedB.
+    ///
+    /// @return the interval `[b,e)` of intersection, which is such
+    /// that `b==e` when there is no intersection.
+    Interval rowInterval( const Point& p, Dimension a, Dimension k0,
+                          const std::vector< Integer >& B ) const;
+
+    /// Counts the lattice points of the rows along axis \a a, each
+    /// row being intersected with the half-spaces of indices \a k0
+    /// and more, seen as strict inequalities with bounds \a B.
+    ///
+    /// @param a any axis between 0 (included) and `dimension` (excluded).
+    /// @param k0 the index of the first half-space.
+    /// @param B either myInteriorB or myClosedB.
+    ///
+    /// @return the number of lattice points.
+    Integer countRows( Dimension a, Dimension k0,
+                       const std::vector< Integer >& B ) const;
   };
 
 } // namespace DGtal
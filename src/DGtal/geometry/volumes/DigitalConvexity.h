@@ -40,6 +40,7 @@
 
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
+#include <array>
 #include <iostream>
 #include <list>
 #include <vector>
@@ -99,6 +100,16 @@ namespace DGtal
     
     static const Dimension dimension = KSpace::dimension;
 
+    /// Scratch structures used by full convexity checks. Giving the
+    /// same object to successive calls avoids to reallocate them,
+    /// which matters when checking many small sets.
+    struct Scratch {
+      PointRange Y; ///< buffer for Minkowski sums
+      PointRange Z; ///< buffer for Minkowski sums
+      PointRange W; ///< buffer for Minkowski sums
+      std::vector< Interval > rows; ///< intervals of d-cells along rows
+    };
+
 
     /// @name Standard services (construction, initialization, assignment)
     /// @{
@@ -423,6 +434,26 @@ namespace DGtal
     /// DigitalConvexity::isFullyConvex if (1) the set is indeed is
     /// fully convex, (2) the dimension is high (>= 3 or 4).
     bool isFullyConvexFast( const PointRange& X ) const;
+
+    /// Tells if a given point range \a X is fully digitally
+    /// convex. Same as DigitalConvexity::isFullyConvexFast( X ), but
+    /// uses the given scratch structures.
+    ///
+    /// @param X any range of \b pairwise \b distinct points
+    /// @param scratch the scratch structures, which may be reused
+    /// by successive calls.
+    /// @return 'true' iff \a X is fully digitally convex.
+    bool isFullyConvexFast( const PointRange& X, Scratch& scratch ) const;
+
+    /// Tells for each given point range if it is fully digitally
+    /// convex, as DigitalConvexity::isFullyConvexFast. Sets are
+    /// checked in parallel when DGtal is built with OpenMP, and each
+    /// thread reuses its scratch structures from one set to the next.
+    ///
+    /// @param XX any range of ranges of \b pairwise \b distinct points
+    /// @return for each range of \a XX, 'true' iff it is fully
+    /// digitally convex.
+    std::vector< bool > areFullyConvex( const std::vector< PointRange >& XX ) const;
     
     /// Tells if a given set of points Y is digitally fully subconvex to
     /// some lattice set \a Star_X, i.e. the cell cover of some set X
@@ -587,6 +618,22 @@ namespace DGtal
     /// represented as lattice points with Khalimsky coordinates.
     Integer sizeStarCvxH( const PointRange& X ) const;
 
+    /// Computes the number of cells in Star(CvxH(X)) for X a digital
+    /// set. Same as DigitalConvexity::sizeStarCvxH( X ), but uses the
+    /// given scratch structures.
+    ///
+    /// @param X any range of lattice points
+    /// @param scratch the scratch structures, which may be reused
+    /// by successive calls.
+    ///
+    /// @return the number of cells touching the convex hull of X,
+    /// represented as lattice points with Khalimsky coordinates.
+    ///
+    /// @note Rows of cells along the longest axis of the polytope are
+    /// computed and counted in parallel when DGtal is built with
+    /// OpenMP and there are many rows.
+    Integer sizeStarCvxH( const PointRange& X, Scratch& scratch ) const;
+
     /// Builds the cell complex Star(X) for X a digital set,
     /// represented as a lattice set (stacked row representation).
     ///
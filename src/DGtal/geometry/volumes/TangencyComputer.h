@@ -65,6 +65,14 @@ namespace DGtal
      provides services to compute all the cotangent points to a given
      point, or to compute shortest paths.
 
+     Computing geodesic distances on big digital sets is dominated by
+     the breadth-first traversals that extract the cotangent points
+     of each expanded point. These lists may be computed once for all
+     points with precomputeCotangentPoints (in parallel when OpenMP is
+     available), then ShortestPaths uses them instead of traversing
+     the set again, and distances to many sources may be computed at
+     once with shortestDistances (one source per thread).
+
      @see moduleDigitalConvexityApplications
 
      @tparam TKSpace an arbitrary model of CCellularGridSpaceND.
@@ -348,7 +356,11 @@ namespace DGtal
 
     protected:
 
-      /// Updates the queue with the cotangent points of the point given in parameter.
+      /// Updates the queue with the cotangent points of the point
+      /// given in parameter. If the tangency computer has
+      /// precomputed cotangent points, they are used directly
+      /// (then the algorithm is exact whatever the value of \ref
+      /// mySecure), otherwise they are extracted by a bft.
       ///
       /// @param current the index of the point where we determine its
       /// adjacent (here cotangent) to update the queue of the bft.
@@ -503,6 +515,33 @@ namespace DGtal
     std::vector< Index >
     getCotangentPoints( const Point& a,
                         const std::vector< bool > & to_avoid ) const;
+
+    /// Computes and stores the cotangent points of every point of
+    /// the digital set (see getCotangentPoints), so that later
+    /// shortest paths computations no longer traverse the set. The
+    /// points are processed in parallel when OpenMP is available.
+    ///
+    /// @note Takes O(n m) memory, where \a m is the average number
+    /// of cotangent points of a point. The stored lists are cleared
+    /// by init.
+    void precomputeCotangentPoints();
+
+    /// @return 'true' iff the cotangent points of every point were
+    /// computed by precomputeCotangentPoints.
+    bool hasPrecomputedCotangentPoints() const
+    { return ! myCotangentOffsets.empty(); }
+
+    /// @param[in] i any valid point index
+    /// @return the range of the indices of the points cotangent to point \a i.
+    /// @pre `hasPrecomputedCotangentPoints()`
+    std::pair< typename std::vector< Index >::const_iterator,
+               typename std::vector< Index >::const_iterator >
+    precomputedCotangentPoints( Index i ) const
+    {
+      ASSERT( hasPrecomputedCotangentPoints() && i < size() );
+      return std::make_pair( myCotangentIndices.cbegin() + myCotangentOffsets[ i ],
+                             myCotangentIndices.cbegin() + myCotangentOffsets[ i+1 ] );
+    }
     
     /// @}
     
@@ -589,6 +628,26 @@ namespace DGtal
     shortestPath( Index source, Index target,
                   double secure = sqrt( KSpace::dimension ),
                   bool verbose = false ) const;
+
+    /// Computes the geodesic distances from each source to each
+    /// target. There is one bft per source, which stops as soon as
+    /// all the targets are visited, and the sources are processed in
+    /// parallel when OpenMP is available. It is worth calling
+    /// precomputeCotangentPoints before when there are many sources.
+    ///
+    /// @param[in] sources the indices of the `n` source points.
+    /// @param[in] targets the indices of the `m` target points.
+    ///
+    /// @param secure This value is used to prune vertices in the
+    /// bft (see makeShortestPaths).
+    ///
+    /// @return a `n x m` array, whose element `[i][j]` is the
+    /// distance between `sources[i]` and `targets[j]`, or
+    /// ShortestPaths::infinity() if there is no path between them.
+    std::vector< std::vector< double > >
+    shortestDistances( const std::vector< Index >& sources,
+                       const std::vector< Index >& targets,
+                       double secure = sqrt( KSpace::dimension ) ) const;
     
     /// @}
     
@@ -617,6 +676,12 @@ namespace DGtal
     
     /// A map giving for each point its index.
     std::unordered_map< Point, Index > myPt2Index;
+
+    /// The offsets of the precomputed cotangent points of each point in
+    /// \ref myCotangentIndices (size n+1), or empty if not computed.
+    std::vector< Index > myCotangentOffsets;
+    /// The concatenated lists of precomputed cotangent points.
+    std::vector< Index > myCotangentIndices;
     
     // ------------------------- Private Datas --------------------------------
   private:
@@ -0,0 +1,512 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file DenseFMM.h
+ *
+ * @brief Fast Marching Method on dense rectangular domains
+ *
+ * This file is part of the DGtal library.
+ *
+ */
+
+#if defined(DenseFMM_RECURSES)
+#error Recursive header files inclusion detected in DenseFMM.h
+#else // defined(DenseFMM_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define DenseFMM_RECURSES
+
+#if !defined DenseFMM_h
+/** Prevents repeated inclusion of headers. */
+#define DenseFMM_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <array>
+#include <limits>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/ConstAlias.h"
+#include "DGtal/images/CImage.h"
+#include "DGtal/kernel/CPointPredicate.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class DenseFMM
+  /**
+   * Description of template class 'DenseFMM' <p>
+   * \brief Aim: Fast Marching Method (FMM) for nd distance transforms
+   * within a rectangular domain, with dense internal data structures.
+   *
+   * This class computes the same signed distance function as FMM
+   * with its default point functor (L2FirstOrderLocalDistance), but
+   * the set of accepted points and the tentative distance values are
+   * stored in arrays covering the image domain (one byte for the
+   * state, far, trial, accepted or outside, and one value per point),
+   * and the candidate points are ordered by a binary heap of (value,
+   * index) pairs stored in a single vector. When the tentative value
+   * of a candidate decreases, a new pair is pushed and the old one
+   * is skipped when it reaches the top of the heap. Thus, there is
+   * no allocation per point, and all the operations on the accepted
+   * points take a constant time, instead of the logarithmic time of
+   * the STL set of pairs of FMM.
+   *
+   * The accepted points are initialized with insertAccepted (or
+   * initFromPointsRange, initFromBelsRange,
+   * initFromIncidentPointsRange, which mirror the static functions of
+   * FMM), then the distance is computed either by marching out with
+   * compute or computeOneStep, or by fast sweeping with
+   * computeBySweeping. The final distance values are written in the
+   * image, which may be of any type, only the domain of the image
+   * being used for the internal arrays.
+   *
+   * Fast sweeping solves the same discrete equation by Gauss-Seidel
+   * iterations along the \f$ 2^d \f$ diagonal directions. The domain is
+   * cut into blocks, and the blocks of a checkerboard coloring are
+   * processed in parallel (with OpenMP), only when one of their
+   * neighbor blocks changed. The result does not depend on the number
+   * of threads. It is worth using on large volumes with few sources,
+   * but it is restricted to non-negative distance values.
+   *
+   * @tparam TImage any model of CImage defined on a HyperRectDomain,
+   * whose values are floating-point numbers
+   * @tparam TPointPredicate any model of concepts::CPointPredicate,
+   * used to bound the computation within the domain of the image
+   *
+   * @see FMM
+   * @see testDenseFMM.cpp
+   */
+  template <typename TImage, typename TPointPredicate>
+  class DenseFMM
+  {
+
+    // ----------------------- Types ------------------------------
+  public:
+
+    //concept assert
+    BOOST_CONCEPT_ASSERT(( concepts::CImage<TImage> ));
+    BOOST_CONCEPT_ASSERT(( concepts::CPointPredicate<TPointPredicate> ));
+
+    typedef TImage Image;
+    typedef TPointPredicate PointPredicate;
+
+    //domain and points
+    typedef typename Image::Domain Domain;
+    typedef typename Domain::Point Point;
+    typedef typename Domain::Vector Vector;
+    typedef typename Domain::Size Size;
+    typedef typename Domain::Dimension Dimension;
+    BOOST_STATIC_ASSERT(( boost::is_same< Domain,
+                          HyperRectDomain< typename Domain::Space > >::value ));
+    BOOST_STATIC_ASSERT(( boost::is_same< Point, typename PointPredicate::Point >::value ));
+    BOOST_STATIC_CONSTANT( Dimension, dimension = Domain::Space::dimension );
+
+    //distance
+    typedef typename Image::Value Value;
+    BOOST_STATIC_ASSERT(( boost::is_floating_point<Value>::value ));
+
+    /// Area, in number of accepted points
+    typedef DGtal::uint64_t Area;
+
+    /// The state of a point during the computation.
+    enum State {
+      Far = 0,      ///< not reached yet (or not tested)
+      Trial = 1,    ///< candidate, with a tentative value
+      Accepted = 2, ///< final value
+      Outside = 3   ///< out of the point predicate
+    };
+
+  private:
+
+    /// A point index and its value in the heap of candidates.
+    struct Candidate
+    {
+      Value key;
+      Size index;
+    };
+
+    /// Orders the heap of candidates, the one of min value at the top.
+    struct CandidateCompare
+    {
+      bool operator()( const Candidate & a, const Candidate & b ) const
+      {
+        return ( a.key > b.key ) || ( ( a.key == b.key ) && ( a.index > b.index ) );
+      }
+    };
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param aImg the image in which the distance values are written
+     * (only the accepted points are set).
+     * @param aPointPredicate a point predicate that returns 'true'
+     * inside the domain where the distance transform is performed.
+     */
+    DenseFMM( Image& aImg, ConstAlias<PointPredicate> aPointPredicate );
+
+    /**
+     * Constructor.
+     *
+     * @param aImg the image in which the distance values are written
+     * (only the accepted points are set).
+     * @param aPointPredicate a point predicate that returns 'true'
+     * inside the domain where the distance transform is performed.
+     * @param aAreaThreshold area threshold (in number of accepted
+     * points) above which the propagation stops.
+     * @param aValueThreshold value threshold (in absolute value)
+     * above which the propagation stops.
+     */
+    DenseFMM( Image& aImg, ConstAlias<PointPredicate> aPointPredicate,
+              const Area& aAreaThreshold, const Value& aValueThreshold );
+
+    /**
+     * Destructor.
+     */
+    ~DenseFMM();
+
+    // ----------------------- Initialization ---------------------------------
+  public:
+
+    /**
+     * Inserts a point into the set of accepted points, with its value
+     * (the value is also set in the image).
+     *
+     * @pre the computation has not started yet.
+     * @param aPoint a point of the image domain.
+     * @param aValue its distance value.
+     */
+    void insertAccepted( const Point& aPoint, const Value& aValue );
+
+    /**
+     * Inserts the points of the range [@a itb , @a ite ) into the set
+     * of accepted points, with a distance equal to @a aValue.
+     *
+     * @param itb begin iterator (on points)
+     * @param ite end iterator (on points)
+     * @param aValue distance default value
+     */
+    template <typename TIteratorOnPoints>
+    void initFromPointsRange( const TIteratorOnPoints& itb, const TIteratorOnPoints& ite,
+                              const Value& aValue );
+
+    /**
+     * Inserts the points incident to the signed cells of the range
+     * [@a itb , @a ite ) into the set of accepted points.  Assign to
+     * the inner points a distance equal to - @a aValue if @a
+     * aFlagIsPositive is 'true' (default) but @a aValue otherwise,
+     * and conversely for the outer points.
+     *
+     * @param aK a Khalimsky space in which the signed cells live.
+     * @param itb begin iterator (on signed cells)
+     * @param ite end iterator (on signed cells)
+     * @param aValue distance default value
+     * @param aFlagIsPositive The flag controlling the \a aValue sign assigned to inner points.
+     */
+    template <typename KSpace, typename TIteratorOnBels>
+    void initFromBelsRange( const KSpace& aK,
+                            const TIteratorOnBels& itb, const TIteratorOnBels& ite,
+                            const Value& aValue,
+                            bool aFlagIsPositive = true );
+
+    /**
+     * Inserts the inner and outer points of the range [@a itb , @a
+     * ite ) of pairs of points into the set of accepted points.
+     * Assign to the inner points a distance equal to - @a aValue if
+     * @a aFlagIsPositive is 'true' (default) but @a aValue otherwise,
+     * and conversely for the outer points.
+     *
+     * @param itb begin iterator (on pairs of points)
+     * @param ite end iterator (on pairs of points)
+     * @param aValue distance default value
+     * @param aFlagIsPositive The flag controlling the \a aValue sign assigned to inner points.
+     */
+    template <typename TIteratorOnPairs>
+    void initFromIncidentPointsRange( const TIteratorOnPairs& itb, const TIteratorOnPairs& ite,
+                                      const Value& aValue,
+                                      bool aFlagIsPositive = true );
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Computation of the signed distance function by marching out
+     * from the initial set of accepted points.
+     * While it is possible, the candidate of min distance is
+     * inserted into the set of accepted points.
+     *
+     * @see computeOneStep
+     */
+    void compute();
+
+    /**
+     * Inserts the candidate of min distance into the set
+     * of accepted points if it is possible and then
+     * updates the distance values of its neighbors.
+     *
+     * @param aPoint inserted point (if inserted)
+     * @param aValue its distance value (if inserted)
+     *
+     * @return 'true' if the point of min distance is accepted
+     * 'false' otherwise.
+     */
+    bool computeOneStep( Point& aPoint, Value& aValue );
+
+    /**
+     * Computation of the distance function by fast sweeping, instead
+     * of compute. All the points of the predicate whose distance is
+     * below the value threshold are accepted (the area threshold is
+     * not used). The blocks of the same color of a checkerboard are
+     * processed in parallel when OpenMP is available.
+     *
+     * @pre the computation has not started yet and the values of
+     * the initial accepted points are non-negative.
+     * @param aBlockSize the number of points of a block along each axis.
+     */
+    void computeBySweeping( Size aBlockSize = 32 );
+
+    /**
+     * @param aPoint a point of the image domain.
+     * @return the state of @a aPoint (see State).
+     */
+    State state( const Point& aPoint ) const;
+
+    /**
+     * @param aPoint a point of the image domain.
+     * @return 'true' if the distance value of @a aPoint is known.
+     */
+    bool isAccepted( const Point& aPoint ) const;
+
+    /**
+     * @return the number of accepted points.
+     */
+    Area nbAccepted() const;
+
+    /**
+     * Minimal distance value in the set of accepted points.
+     *
+     * @return minimal distance value.
+     */
+    Value min() const;
+
+    /**
+     * Maximal distance value in the set of accepted points.
+     *
+     * @return maximal distance value
+     */
+    Value max() const;
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// Reference on the image
+    Image& myImage;
+
+    /// Aliasing pointer on the point predicate bounding the computation
+    const PointPredicate* myPointPredicate;
+
+    /// Domain of the image
+    Domain myDomain;
+
+    /// For each axis, the offset between consecutive points in the arrays
+    std::array<Size, dimension> myStrides;
+
+    /// State of each point (see State)
+    std::vector<unsigned char> myStates;
+
+    /// Distance value of each point (infinite when unknown)
+    std::vector<Value> myValues;
+
+    /// Heap of candidates, possibly with outdated values
+    std::vector<Candidate> myCandidates;
+
+    /// Indices of the initial accepted points
+    std::vector<Size> mySeeds;
+
+    /// 'true' when the computation has started
+    bool myFlagIsStarted;
+
+    /// Number of accepted points
+    Area myNbAccepted;
+
+    /// Area threshold above which the propagation stops
+    Area myAreaThreshold;
+
+    /// Value threshold above which the propagation stops
+    Value myValueThreshold;
+
+    /// Min value
+    Value myMinValue;
+
+    /// Max value
+    Value myMaxValue;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * Copy constructor.
+     * @param other the object to clone.
+     * Forbidden by default.
+     */
+    DenseFMM ( const DenseFMM & other );
+
+    /**
+     * Assignment.
+     * @param other the object to copy.
+     * @return a reference on 'this'.
+     * Forbidden by default.
+     */
+    DenseFMM & operator= ( const DenseFMM & other );
+
+    // ------------------------- Internals ------------------------------------
+  private:
+
+    /**
+     * Allocates the arrays and sets the strides.
+     */
+    void allocate();
+
+    /**
+     * @param aPoint a point of the image domain.
+     * @return its index in the arrays.
+     */
+    Size index( const Point& aPoint ) const;
+
+    /**
+     * @param anIndex an index in the arrays.
+     * @return the corresponding point.
+     */
+    Point point( Size anIndex ) const;
+
+    /**
+     * Starts the computation: the neighbors of the initial accepted
+     * points become candidates.
+     */
+    void init();
+
+    /**
+     * Sets the min and max values from the initial accepted points.
+     */
+    void initMinMax();
+
+    /**
+     * Updates the tentative values of the neighbors of the newly
+     * accepted point @a aPoint.
+     *
+     * @param anIndex the index of @a aPoint.
+     * @param aPoint a point.
+     */
+    void update( Size anIndex, const Point& aPoint );
+
+    /**
+     * Computes the distance value at @a aPoint from the known values
+     * of its 1-neighbors.
+     *
+     * @param anIndex the index of @a aPoint.
+     * @param aPoint a point.
+     * @param aFlagAcceptedOnly when 'true', only the values of the
+     * accepted neighbors are used (marching), otherwise all the
+     * finite values are used (sweeping).
+     * @param aValue (returned) the distance value.
+     *
+     * @return 'false' if no neighbor value is known, 'true' otherwise.
+     */
+    bool localDistance( Size anIndex, const Point& aPoint,
+                        bool aFlagAcceptedOnly, Value& aValue ) const;
+
+    /**
+     * Euclidean distance from the distance values of some neighbors,
+     * one per axis, such that the upwind gradient is one (see
+     * L2FirstOrderLocalDistance).
+     *
+     * @param someValues the neighbor values (modified).
+     * @param aNbValues the number of values, at least one.
+     *
+     * @return the computed distance.
+     */
+    static Value solve( std::array<Value, dimension>& someValues, Dimension aNbValues );
+
+    /**
+     * Sweeps a block of points along all the diagonal directions
+     * until its values no longer change.
+     *
+     * @param aLower the lower bound of the block.
+     * @param anUpper the upper bound of the block.
+     *
+     * @return 'true' if a value has changed.
+     */
+    bool sweepBlock( const Point& aLower, const Point& anUpper );
+
+    /**
+     * Updates the value of a point during sweeping.
+     *
+     * @param anIndex the index of @a aPoint.
+     * @param aPoint a point.
+     *
+     * @return 'true' if its value has decreased.
+     */
+    bool sweepPoint( Size anIndex, const Point& aPoint );
+
+  }; // end of class DenseFMM
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'DenseFMM'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'DenseFMM' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TImage, typename TPointPredicate>
+  std::ostream&
+  operator<< ( std::ostream & out, const DenseFMM<TImage, TPointPredicate> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/volumes/distance/DenseFMM.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined DenseFMM_h
+
+#undef DenseFMM_RECURSES
+#endif // else defined(DenseFMM_RECURSES)
@@ -42,11 +42,13 @@
 // Inclusions
 #include <iostream>
 #include <cmath>
+#include <type_traits>
 #include "DGtal/base/Common.h"
 #include "DGtal/math/BasicMathFunctions.h"
 #include "DGtal/kernel/CInteger.h"
 #include "DGtal/kernel/CSpace.h"
 #include "DGtal/kernel/CInteger.h"
+#include "DGtal/geometry/volumes/distance/SeparableMetricTraits.h"
 //////////////////////////////////////////////////////////////////////////////
 
 namespace DGtal
@@ -75,6 +77,15 @@ namespace DGtal
    * type @a TPromoted allows to store sums of @f$ |x_i-y_i|^p@f$
    * quantities.
    *
+   * The class also provides the 1D span kernels described in
+   * SeparableMetricTraits (@a partialRawDistance and line versions of
+   * @a closest and @a hiddenBy): VoronoiMap computes the partial norm
+   * of each site once per span and runs the lower envelope predicates
+   * on (abscissa, partial norm) pairs only. For p=2, @a hiddenBy is
+   * the constant-time parabola intersection test, for p=1 the
+   * bisector abscissa is computed in closed form instead of by
+   * binary search.
+   *
    * @tparam TSpace the model of CSpace on which the metric is
    * defined.
    * @tparam p the exponent of the metric (static DGtal::uint32_t)
@@ -98,6 +109,8 @@ namespace DGtal
     typedef typename Point::Coordinate Abscissa;
     ///Type for vectors
     typedef typename Space::Vector Vector;
+    ///Type for dimensions
+    typedef typename Space::Dimension Dimension;
 
     ///Type for internal distance values
     typedef TRawValue RawValue;
@@ -208,6 +221,53 @@ namespace DGtal
                   const Point &endPoint,
                   const typename Point::UnsignedComponent dim) const;
 
+    /**
+     * Compute the partial raw distance between @a aP and @a aQ,
+     * discarding dimension @a dim (i.e. @f$ \sum_{i \neq dim} |x_i-y_i |^p\f$).
+     * @param aP a first point.
+     * @param aQ a second point.
+     * @param dim the discarded dimension.
+     * @return the partial raw distance between aP and aQ.
+     */
+    RawValue partialRawDistance(const Point & aP, const Point &aQ,
+                                const Dimension dim) const;
+
+    /**
+     * Line version of closest(): the origin and the two points are
+     * given by their abscissa along a straight line and, for the two
+     * points, by their partial raw distance to the line (see
+     * partialRawDistance and SeparableMetricTraits).
+     * @param origin the origin abscissa
+     * @param first  the first point abscissa
+     * @param nfirst the first point partial raw distance to the line
+     * @param second the second point abscissa
+     * @param nsecond the second point partial raw distance to the line
+     * @return a Closest enum: FIRST, SECOND or BOTH.
+     */
+    Closest closest(const Abscissa origin,
+                    const Abscissa first, const RawValue nfirst,
+                    const Abscissa second, const RawValue nsecond) const;
+
+    /**
+     * Line version of hiddenBy(): the three sites are given by
+     * their abscissa along the straight line and their partial raw
+     * distance to it (see partialRawDistance and SeparableMetricTraits).
+     * @pre u < v < w
+     * @param u abscissa of the first site
+     * @param nu partial raw distance of the first site
+     * @param v abscissa of the second site
+     * @param nv partial raw distance of the second site
+     * @param w abscissa of the third site
+     * @param nw partial raw distance of the third site
+     * @param lower abscissa of the segment starting point
+     * @param upper abscissa of the segment end point
+     * @return true if (u,w) hides v (strictly).
+     */
+    bool hiddenBy(const Abscissa u, const RawValue nu,
+                  const Abscissa v, const RawValue nv,
+                  const Abscissa w, const RawValue nw,
+                  const Abscissa lower, const Abscissa upper) const;
+
 
     /**
      * Writes/Displays the object on an output stream.
@@ -271,6 +331,8 @@ namespace DGtal
     typedef typename Point::Coordinate Abscissa;
     ///Type for vectors
     typedef typename Space::Vector Vector;
+    ///Type for dimensions
+    typedef typename Space::Dimension Dimension;
 
     ///Type for internal distance values
     typedef TRawValue RawValue;
@@ -395,6 +457,74 @@ namespace DGtal
                   const Point &endPoint,
                   const typename Point::UnsignedComponent dim) const;
 
+    /**
+     * Compute the partial raw distance between @a aP and @a aQ,
+     * discarding dimension @a dim (i.e. @f$ \sum_{i \neq dim} |x_i-y_i |^p\f$).
+     * @param aP a first point.
+     * @param aQ a second point.
+     * @param dim the discarded dimension.
+     * @return the partial raw distance between aP and aQ.
+     */
+    RawValue partialRawDistance(const Point & aP, const Point &aQ,
+                                const Dimension dim) const;
+
+    /**
+     * Line version of closest(): the origin and the two points are
+     * given by their abscissa along a straight line and, for the two
+     * points, by their partial raw distance to the line (see
+     * partialRawDistance and SeparableMetricTraits).
+     * @param origin the origin abscissa
+     * @param first  the first point abscissa
+     * @param nfirst the first point partial raw distance to the line
+     * @param second the second point abscissa
+     * @param nsecond the second point partial raw distance to the line
+     * @return a Closest enum: FIRST, SECOND or BOTH.
+     */
+    Closest closest(const Abscissa origin,
+                    const Abscissa first, const RawValue nfirst,
+                    const Abscissa second, const RawValue nsecond) const;
+
+    /**
+     * Line version of hiddenBy(): the three sites are given by
+     * their abscissa along the straight line and their partial raw
+     * distance to it (see partialRawDistance and SeparableMetricTraits).
+     * @pre u < v < w
+     * @param u abscissa of the first site
+     * @param nu partial raw distance of the first site
+     * @param v abscissa of the second site
+     * @param nv partial raw distance of the second site
+     * @param w abscissa of the third site
+     * @param nw partial raw distance of the third site
+     * @param lower abscissa of the segment starting point
+     * @param upper abscissa of the segment end point
+     * @return true if (u,w) hides v (strictly).
+     */
+    bool hiddenBy(const Abscissa u, const RawValue nu,
+                  const Abscissa v, const RawValue nv,
+                  const Abscissa w, const RawValue nw,
+                  const Abscissa lower, const Abscissa upper) const;
+
+    /**
+     * Batched version of the line closest(): given @a count sites by
+     * their (increasing) abscissas and partial raw distances to the
+     * straight line, computes at once, for each pair of consecutive
+     * sites (k,k+1), the smallest abscissa that is not strictly closer
+     * to site k than to site k+1. Hence, for any abscissa x,
+     * closest( x, abscissas[k], norms[k], abscissas[k+1], norms[k+1] )
+     * is ClosestFIRST iff x < switches[k].
+     *
+     * @pre abscissas are strictly increasing and RawValue is an
+     * integral type (see SeparableMetricTraits).
+     * @param abscissas the site abscissas (@a count values).
+     * @param norms the site partial raw distances (@a count values).
+     * @param count the number of sites.
+     * @param switches the computed abscissas (@a count - 1 values).
+     */
+    void closestSwitches(const Abscissa * abscissas,
+                         const RawValue * norms,
+                         const std::size_t count,
+                         RawValue * switches) const;
+
    // ----------------------- Other services --------------------------------------
     /**
      * Writes/Displays the object on an output stream.
@@ -438,6 +568,18 @@ namespace DGtal
 
   }; // end of class ExactPredicateLpSeparableMetric
 
+  /**
+   * ExactPredicateLpSeparableMetric provides the 1D span kernels, and
+   * the batched closest() kernel for l_2.
+   */
+  template <typename TSpace, DGtal::uint32_t p, typename TRawValue>
+  struct SeparableMetricTraits< ExactPredicateLpSeparableMetric<TSpace, p, TRawValue> >
+  {
+    static const bool hasLineKernels = true;
+    /// Exact bisector abscissas only for l_2 with integral raw values.
+    static const bool hasBatchedClosest = ( p == 2 ) && std::is_integral<TRawValue>::value;
+  };
+
   /**
    * Overloads 'operator<<' for displaying objects of class 'ExactPredicateLpSeparableMetric'.
    * @param out the output stream where the object is written.
@@ -0,0 +1,96 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file SeparableMetricTraits.h
+ *
+ * Header file for module SeparableMetricTraits
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(SeparableMetricTraits_RECURSES)
+#error Recursive header files inclusion detected in SeparableMetricTraits.h
+#else // defined(SeparableMetricTraits_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define SeparableMetricTraits_RECURSES
+
+#if !defined SeparableMetricTraits_h
+/** Prevents repeated inclusion of headers. */
+#define SeparableMetricTraits_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include "DGtal/base/Common.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class SeparableMetricTraits
+  /**
+   * Description of template class 'SeparableMetricTraits' <p>
+   * \brief Aim: Optional services of a separable metric (model of
+   * concepts::CSeparableMetric) used by Voronoi map computations.
+   *
+   * Along a 1D span in direction @a dim, a site @a s only enters the
+   * metric computations through its abscissa @a s[dim] and its
+   * partial raw distance to the span (the terms of the raw distance
+   * along the other dimensions). When @a hasLineKernels is true, the
+   * metric provides, in addition to the concepts::CSeparableMetric
+   * services:
+   *
+   * - RawValue partialRawDistance( const Point & aP, const Point & aQ, Dimension dim ) const
+   * - Closest closest( Abscissa origin, Abscissa first, RawValue nfirst,
+   *                    Abscissa second, RawValue nsecond ) const
+   * - bool hiddenBy( Abscissa u, RawValue nu, Abscissa v, RawValue nv,
+   *                  Abscissa w, RawValue nw, Abscissa lower, Abscissa upper ) const
+   *
+   * so that VoronoiMap computes partial distances once per site and
+   * per span instead of at each predicate call. When @a
+   * hasBatchedClosest is also true, the metric provides
+   *
+   * - void closestSwitches( const Abscissa * abscissas, const RawValue * norms,
+   *                         std::size_t count, RawValue * switches ) const
+   *
+   * which computes in one call, for all the consecutive sites of the
+   * lower envelope of a span, the abscissa where the first one stops
+   * being the closest, so that the rewriting of the span only compares
+   * abscissas.
+   *
+   * @tparam TSeparableMetric a model of concepts::CSeparableMetric.
+   */
+  template <typename TSeparableMetric>
+  struct SeparableMetricTraits
+  {
+    /// True if the metric provides the 1D span kernels.
+    static const bool hasLineKernels = false;
+    /// True if the metric provides the batched closest kernel.
+    static const bool hasBatchedClosest = false;
+  };
+
+} // namespace DGtal
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined SeparableMetricTraits_h
+
+#undef SeparableMetricTraits_RECURSES
+#endif // else defined(SeparableMetricTraits_RECURSES)
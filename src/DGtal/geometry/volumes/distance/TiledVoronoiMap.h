@@ -0,0 +1,388 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file TiledVoronoiMap.h
+ * @brief Out-of-core separable Voronoi map and distance transformation.
+ *
+ * Header file for module TiledVoronoiMap.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testTiledVoronoiMap.cpp
+ */
+
+#if defined(TiledVoronoiMap_RECURSES)
+#error Recursive header files inclusion detected in TiledVoronoiMap.h
+#else // defined(TiledVoronoiMap_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define TiledVoronoiMap_RECURSES
+
+#if !defined TiledVoronoiMap_h
+/** Prevents repeated inclusion of headers. */
+#define TiledVoronoiMap_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include <type_traits>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Alias.h"
+#include "DGtal/base/ConstAlias.h"
+#include "DGtal/images/CImage.h"
+#include "DGtal/images/CImageFactory.h"
+#include "DGtal/kernel/CPointPredicate.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+#include "DGtal/kernel/domains/Linearizer.h"
+#include "DGtal/geometry/volumes/distance/CSeparableMetric.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class TiledVoronoiMap
+  /**
+   * Description of template class 'TiledVoronoiMap' <p>
+   * \brief Aim: Out-of-core computation of the separable Voronoi map
+   * (and distance transformation) of images that do not fit in memory.
+   *
+   * The algorithm is the one of VoronoiMap (@cite Maurer2003PAMI
+   * @cite dcoeurjo_these) but the map is never stored as a whole:
+   * it is read from and written to an image factory (model of
+   * concepts::CImageFactory, e.g. ImageFactoryFromHDF5) that plays
+   * the role of the storage backend of a TiledImage.
+   *
+   * Since the factory output image values must be scalars, the closest
+   * site of each point is stored as its linearized index in the
+   * factory domain (see Linearizer), a negative label meaning that no
+   * site has been found.
+   *
+   * The domain is cut into @a N tiles per dimension, as in TiledImage.
+   * The map is computed one axis pass at a time: for the pass along
+   * dimension @a dim, the lines of each tile column (tiles sharing the
+   * same block coordinates except along @a dim) are requested from the
+   * factory as a single batch, processed and flushed back. When a
+   * batch contains more voxels than the tile budget, its cross-section
+   * is recursively split until it fits (or reduces to a single
+   * line). Peak memory is therefore bounded by the tile budget instead
+   * of the volume size.
+   *
+   * The point predicate is evaluated in the same tile-aligned order,
+   * sequentially, so that it may itself read a TiledImage. Inside a
+   * batch, if DGtal has been built with OpenMP support, the 1D
+   * problems are solved in parallel.
+   *
+   * Only non-periodic domains are handled.
+   *
+   * @code
+   * typedef ImageContainerBySTLVector<Z3i::Domain, DGtal::int64_t> LabelImage;
+   * typedef ImageFactoryFromHDF5<LabelImage> LabelFactory;
+   * LabelFactory factory( "voronoi.h5", "Int64Array3D" );
+   *
+   * // At most 64^3 voxels in memory, 16 tiles per dimension.
+   * TiledVoronoiMap<LabelFactory, Predicate, Z3i::L2Metric>
+   *   voronoi( factory, predicate, Z3i::l2Metric, 16, 64*64*64 );
+   * @endcode
+   *
+   * @tparam TImageFactory a model of concepts::CImageFactory whose
+   * output images are defined on HyperRectDomain and have signed
+   * integral values (e.g. DGtal::int64_t) large enough to store a
+   * linearized index of the domain.
+   * @tparam TPointPredicate point predicate returning true for points
+   * from which we compute the distance (model of concepts::CPointPredicate)
+   * @tparam TSeparableMetric a model of concepts::CSeparableMetric
+   */
+  template < typename TImageFactory,
+             typename TPointPredicate,
+             typename TSeparableMetric >
+  class TiledVoronoiMap
+  {
+
+  public:
+    BOOST_CONCEPT_ASSERT(( concepts::CImageFactory< TImageFactory > ));
+    BOOST_CONCEPT_ASSERT(( concepts::CPointPredicate< TPointPredicate > ));
+    BOOST_CONCEPT_ASSERT(( concepts::CSeparableMetric< TSeparableMetric > ));
+
+    ///Type of the image factory (storage backend).
+    typedef TImageFactory ImageFactory;
+
+    ///Type of the images (tiles or batches) produced by the factory.
+    typedef typename ImageFactory::OutputImage OutputImage;
+
+    BOOST_CONCEPT_ASSERT(( concepts::CImage< OutputImage > ));
+
+    ///Copy of the point predicate type.
+    typedef TPointPredicate PointPredicate;
+
+    ///Definition of the separable metric type
+    typedef TSeparableMetric SeparableMetric;
+
+    ///Definition of the underlying domain type.
+    typedef typename OutputImage::Domain Domain;
+
+    ///Definition of the space type.
+    typedef typename Domain::Space Space;
+
+    typedef typename Space::Point Point;
+    typedef typename Space::Vector Vector;
+    typedef typename Space::Dimension Dimension;
+    typedef typename Space::Size Size;
+
+    ///Type of the labels (linearized index of the closest site).
+    typedef typename OutputImage::Value Label;
+
+    //OutputImage domain type must be HyperRectangular
+    BOOST_STATIC_ASSERT ((boost::is_same< HyperRectDomain<Space>, Domain >::value ));
+
+    //Labels must be signed integers (negative label for "no site")
+    BOOST_STATIC_ASSERT (( std::is_integral< Label >::value && std::is_signed< Label >::value ));
+
+    ///Both Space points and PointPredicate points must be the same.
+    BOOST_STATIC_ASSERT ((boost::is_same< Point, typename TPointPredicate::Point >::value ));
+
+    ///Linearizer used to encode sites as labels.
+    typedef Linearizer< Domain > SiteLinearizer;
+
+    ///Self type
+    typedef TiledVoronoiMap< TImageFactory, TPointPredicate, TSeparableMetric > Self;
+
+    /**
+     * Constructor.
+     *
+     * Computes the Voronoi map of the sites (points for which the
+     * predicate is false) of the factory domain and writes it, as
+     * labels, through the factory.
+     *
+     * @param anImageFactory alias on the factory used to read and write the map.
+     * @param aPredicate alias on the point predicate defining the
+     * Voronoi sites (false points).
+     * @param aMetric alias on the separable metric instance.
+     * @param N number of tiles per dimension.
+     * @param aBudget maximal number of voxels loaded in memory at once
+     * (at least one full line of the domain is loaded anyway).
+     */
+    TiledVoronoiMap( Alias<ImageFactory> anImageFactory,
+                     ConstAlias<PointPredicate> aPredicate,
+                     ConstAlias<SeparableMetric> aMetric,
+                     typename Domain::Integer N,
+                     Size aBudget );
+
+    /**
+     * Default destructor
+     */
+    ~TiledVoronoiMap() = default;
+
+    /**
+     * Disabling default constructor.
+     */
+    TiledVoronoiMap() = delete;
+
+  public:
+
+    /**
+     * @return the domain of the factory.
+     */
+    const Domain & domain() const
+    {
+      return myImageFactory->domain();
+    }
+
+    /**
+     * @return the label meaning that no site has been found.
+     */
+    static constexpr Label noSite()
+    {
+      return Label( -1 );
+    }
+
+    /**
+     * Label of a site.
+     * @param aSite a point of the domain.
+     * @return its linearized index in the domain.
+     */
+    Label label( const Point & aSite ) const
+    {
+      return static_cast<Label>( SiteLinearizer::getIndex( aSite, myLowerBound, myExtent ) );
+    }
+
+    /**
+     * Site of a label.
+     * @pre @a aLabel is not noSite().
+     * @param aLabel a label read from the factory.
+     * @return the corresponding site.
+     */
+    Point site( const Label aLabel ) const
+    {
+      ASSERT( aLabel != noSite() );
+      return SiteLinearizer::getPoint( static_cast<Size>( aLabel ), myLowerBound, myExtent );
+    }
+
+    /**
+     * @return an alias to the underlying metric.
+     */
+    const SeparableMetric* metric() const
+    {
+      return myMetricPtr;
+    }
+
+    /**
+     * @return the maximal number of voxels loaded at once.
+     */
+    Size budget() const
+    {
+      return myBudget;
+    }
+
+    /**
+     * Writes the distance transformation associated to the Voronoi
+     * map (distance from each point to its closest site) through
+     * another factory, tile by tile. Points without site get the
+     * maximal value of the distance type.
+     *
+     * @tparam TDistanceFactory a model of concepts::CImageFactory
+     * on the same domain, whose output images store metric values.
+     * @param aDistanceFactory the factory used to write the distances.
+     */
+    template <typename TDistanceFactory>
+    void computeDistanceTransformation( TDistanceFactory & aDistanceFactory ) const;
+
+    /**
+     * Self Display method.
+     *
+     * @param out output stream
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const
+    {
+      return myImageFactory->isValid();
+    }
+
+    // ------------------- Private functions ------------------------
+  private:
+
+    /**
+     * Computes the Voronoi map, one axis pass at a time.
+     */
+    void compute();
+
+    /**
+     * Processes the pass along dimension @a dim, tile column by tile column.
+     *
+     * @param [in] dim the dimension to process.
+     */
+    void computeOtherSteps( const Dimension dim ) const;
+
+    /**
+     * Processes a batch of full lines along dimension @a dim, splitting
+     * its cross-section until it fits in the budget.
+     *
+     * @param [in] aBox the batch domain (full extent along @a dim).
+     * @param [in] dim the dimension to process.
+     */
+    void computeBatch( const Domain & aBox, const Dimension dim ) const;
+
+    /**
+     * Updates the map along the 1D span starting at @a row along the
+     * dimension @a dim, inside a batch loaded in memory.
+     *
+     * @param [in,out] aBatch the batch image.
+     * @param [in] row starting point of the 1D process.
+     * @param [in] dim dimension of the update.
+     * @param [in,out] Sites site buffer, cleared and reused.
+     */
+    void computeOtherStep1D( OutputImage & aBatch,
+                             const Point & row,
+                             const Dimension dim,
+                             std::vector<Point> & Sites ) const;
+
+    /**
+     * Domain of the tile of block coordinates @a aCoord (see TiledImage).
+     *
+     * @param [in] aCoord the block coordinates.
+     * @return the tile domain (truncated to the factory domain).
+     */
+    Domain tileDomain( const Point & aCoord ) const;
+
+    /**
+     * @return the domain of the block coordinates of the tiles.
+     */
+    Domain blockCoordsDomain() const;
+
+    // ------------------- Private members ------------------------
+  private:
+
+    ///Alias on the image factory
+    ImageFactory * myImageFactory;
+
+    ///Pointer to the point predicate
+    const PointPredicate * myPointPredicatePtr;
+
+    ///Pointer to the separable metric instance
+    const SeparableMetric * myMetricPtr;
+
+    ///Number of tiles per dimension
+    typename Domain::Integer myN;
+
+    ///Maximal number of voxels in memory
+    Size myBudget;
+
+    ///Copy of the domain lower bound
+    Point myLowerBound;
+
+    ///Copy of the domain upper bound
+    Point myUpperBound;
+
+    ///Domain extent
+    Point myExtent;
+
+    ///Width of a tile (for each dimension)
+    Point myTileSize;
+
+  }; // end of class TiledVoronoiMap
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'TiledVoronoiMap'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'TiledVoronoiMap' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename F, typename P, typename Sep>
+  std::ostream&
+  operator<< ( std::ostream & out, const TiledVoronoiMap<F,P,Sep> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/volumes/distance/TiledVoronoiMap.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined TiledVoronoiMap_h
+
+#undef TiledVoronoiMap_RECURSES
+#endif // else defined(TiledVoronoiMap_RECURSES)
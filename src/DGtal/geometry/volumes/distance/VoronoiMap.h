@@ -53,6 +53,7 @@
 #include "DGtal/kernel/CPointPredicate.h"
 #include "DGtal/kernel/domains/HyperRectDomain.h"
 #include "DGtal/geometry/volumes/distance/CSeparableMetric.h"
+#include "DGtal/geometry/volumes/distance/SeparableMetricTraits.h"
 #include "DGtal/kernel/domains/HyperRectDomain.h"
 #include "DGtal/base/ConstAlias.h"
 //////////////////////////////////////////////////////////////////////////////
@@ -100,7 +101,13 @@ namespace DGtal
    * If DGtal has been built with OpenMP support (WITH_OPENMP flag set
    * to "true"), the computation is done in parallel (multithreaded)
    * in an optimal way: on @a p processors, expected runtime is in
-   * @f$ O(h.d.n^d / p)@f$.
+   * @f$ O(h.d.n^d / p)@f$. The 1D problems of each pass are streamed
+   * by slabs of adjacent lines (no starting point is stored) and each
+   * thread reuses its own site buffer. When the metric provides the
+   * 1D span kernels (see SeparableMetricTraits), the partial norm of
+   * each site is computed once per span and stored next to the site
+   * buffer, the lower envelope predicates then only involve
+   * abscissas and partial norms.
    *
    * This class is a model of concepts::CConstImage.
    *
@@ -345,6 +352,24 @@ namespace DGtal
     void compute ( ) ;
 
 
+    /**
+     * Site buffers of the 1D span computations, stored as a structure
+     * of arrays (one array per site attribute). The arrays other than
+     * @a sites are only filled when the metric provides the
+     * corresponding kernels (see SeparableMetricTraits).
+     */
+    struct SiteBuffers
+    {
+      /// Sites of the lower envelope of the span.
+      std::vector<Point> sites;
+      /// Partial raw distances of the sites to the span.
+      std::vector<typename SeparableMetric::RawValue> norms;
+      /// Abscissas of the sites along the span.
+      std::vector<typename Point::Coordinate> abscissas;
+      /// Abscissas where each site stops being the closest one.
+      std::vector<typename SeparableMetric::RawValue> switches;
+    };
+
     /**
      *  Compute the other steps of the separable Voronoi map.
      *
@@ -359,9 +384,42 @@ namespace DGtal
      *
      * @param [in] row starting point of the 1D process.
      * @param [in] dim dimension of the update.
+     * @param [in,out] buffers site buffers, cleared and reused by the
+     * method (one buffer per thread avoids reallocations per line).
      */
     void computeOtherStep1D (const Point &row,
-                             const Dimension dim) const;
+                             const Dimension dim,
+                             SiteBuffers & buffers) const;
+
+    /**
+     * Number of 1D spans along dimension @a dim in the domain.
+     *
+     * @param [in] dim dimension of the spans.
+     * @return the product of the domain extents along the other dimensions.
+     */
+    std::size_t nbLines( const Dimension dim ) const;
+
+    /**
+     * Starting point of the @a index-th 1D span along dimension @a dim.
+     * Spans are numbered with the lowest remaining dimension varying
+     * fastest, so that consecutive spans are close in the (row-major)
+     * output image.
+     *
+     * @param [in] index index of the span in [0, nbLines(dim)).
+     * @param [in] dim dimension of the span.
+     * @return the starting point (with lower bound along @a dim).
+     */
+    Point lineStartingPoint( std::size_t index, const Dimension dim ) const;
+
+    /**
+     * Number of consecutive 1D spans along dimension @a dim processed
+     * as one work unit (slab), so that the image values accessed by a
+     * slab roughly fit in cache.
+     *
+     * @param [in] dim dimension of the spans.
+     * @return the slab size (at least 1).
+     */
+    std::size_t slabSize( const Dimension dim ) const;
 
     /**
      * Project a coordinate into the domain, taking into account
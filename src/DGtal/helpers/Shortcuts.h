@@ -63,6 +63,7 @@
 #include "DGtal/topology/CCellularGridSpaceND.h"
 #include "DGtal/topology/LightImplicitDigitalSurface.h"
 #include "DGtal/topology/SetOfSurfels.h"
+#include "DGtal/topology/FlatDigitalSurface.h"
 #include "DGtal/topology/DigitalSurface.h"
 #include "DGtal/topology/IndexedDigitalSurface.h"
 #include "DGtal/topology/SurfelAdjacency.h"
@@ -158,6 +159,11 @@ namespace DGtal
       typedef ::DGtal::DigitalSurface< ExplicitSurfaceContainer > DigitalSurface;
       /// defines a connected or not indexed digital surface.
       typedef IndexedDigitalSurface< ExplicitSurfaceContainer >   IdxDigitalSurface;
+      /// defines a flat container that stores all the boundary of a
+      /// binary image with index-based adjacencies.
+      typedef ::DGtal::FlatDigitalSurface< KSpace >               FlatSurfaceContainer;
+      /// defines a (connected or not) digital surface over a flat container.
+      typedef ::DGtal::DigitalSurface< FlatSurfaceContainer >     FlatDigitalSurface;
       typedef typename LightDigitalSurface::Surfel                Surfel;
       typedef typename LightDigitalSurface::Cell                  Cell;
       typedef typename LightDigitalSurface::SCell                 SCell;
@@ -1161,29 +1167,66 @@ namespace DGtal
           }	
         bool surfel_adjacency      = params[ "surfelAdjacency" ].as<int>();
         SurfelAdjacency< KSpace::dimension > surfAdj( surfel_adjacency );
-        // Extracts all boundary surfels
-        SurfelSet all_surfels;
-        Surfaces<KSpace>::sMakeBoundary( all_surfels, K, *bimage,
-                                         K.lowerBound(), K.upperBound() );
+        // Extracts all boundary surfels and labels their connected
+        // components (in parallel).
+        const FlatSurfaceContainer all_surfels( K, *bimage, surfAdj );
+        // The representative of a component is its smallest surfel.
+        SurfelRange reps( all_surfels.nbComponents() );
+        std::vector<bool> has_rep( all_surfels.nbComponents(), false );
+        for ( typename FlatSurfaceContainer::Index i = 0; i < all_surfels.nbSurfels(); ++i )
+          {
+            const auto c = all_surfels.component( i );
+            const Surfel& bel = all_surfels.surfel( i );
+            if ( ! has_rep[ c ] || bel < reps[ c ] )
+              {
+                reps[ c ]    = bel;
+                has_rep[ c ] = true;
+              }
+          }
+        std::sort( reps.begin(), reps.end() );
         // Builds all connected components of surfels.
-        SurfelSet marked_surfels;
         CountedPtr<LightDigitalSurface> ptrSurface;
-        for ( auto bel : all_surfels )
+        for ( auto bel : reps )
           {
-            if ( marked_surfels.count( bel ) != 0 ) continue;
             surfel_reps.push_back( bel );
             LightSurfaceContainer* surfContainer
               = new LightSurfaceContainer( K, *bimage, surfAdj, bel );
             ptrSurface = CountedPtr<LightDigitalSurface>
               ( new LightDigitalSurface( surfContainer ) ); // acquired
-            // mark all surfels of the surface component.
-            marked_surfels.insert( ptrSurface->begin(), ptrSurface->end() );
             // add surface component to result.
             result.push_back( ptrSurface );
           }
         return result;
       }
 
+
+      /// Builds a flat digital surface from a space \a K and a binary
+      /// image \a bimage. It contains all the boundary components of
+      /// the shape within \a K. It is built in parallel when OpenMP is
+      /// available, and its tracker moves in O(1) to adjacent surfels.
+      ///
+      /// @param[in] bimage a binary image representing the characteristic function of a digital shape.
+      /// @param[in] K the Khalimsky space whose domain encompasses the digital shape.
+      ///
+      /// @param[in] params the parameters:
+      ///   - surfelAdjacency   [     0]: specifies the surfel adjacency (1:ext, 0:int)
+      ///
+      /// @return a smart pointer on a flat digital surface that
+      /// represents the whole boundary of the digital shape.
+      static CountedPtr<FlatDigitalSurface>
+        makeFlatDigitalSurface
+        ( CountedPtr<BinaryImage> bimage,
+          const KSpace&           K,
+          const Parameters&       params = parametersDigitalSurface() )
+      {
+        bool surfel_adjacency      = params[ "surfelAdjacency" ].as<int>();
+        SurfelAdjacency< KSpace::dimension > surfAdj( surfel_adjacency );
+        // this pointer will be acquired by the surface.
+        FlatSurfaceContainer* surfContainer
+          = new FlatSurfaceContainer( K, *bimage, surfAdj );
+        return CountedPtr<FlatDigitalSurface>
+          ( new FlatDigitalSurface( surfContainer ) ); // acquired
+      }
     
       /// Creates a explicit digital surface representing the boundaries in
       /// the binary image \a bimage, or any one of its big components
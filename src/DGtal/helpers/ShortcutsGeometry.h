@@ -47,6 +47,10 @@
 #include "DGtal/geometry/surfaces/estimation/VCMDigitalSurfaceLocalEstimator.h"
 #include "DGtal/geometry/surfaces/estimation/IIGeometricFunctors.h"
 #include "DGtal/geometry/surfaces/estimation/IntegralInvariantVolumeEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantSATVolumeEstimator.h"
+#ifdef WITH_FFTW3
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantFFTEstimator.h"
+#endif
 #include "DGtal/geometry/surfaces/estimation/IntegralInvariantCovarianceEstimator.h"
 
 #include "DGtal/dec/DiscreteExteriorCalculusFactory.h"
@@ -135,6 +139,11 @@ namespace DGtal
       typedef ::DGtal::DigitalSurface< ExplicitSurfaceContainer > DigitalSurface;
       /// defines a connected or not indexed digital surface.
       typedef IndexedDigitalSurface< ExplicitSurfaceContainer >   IdxDigitalSurface;
+      /// defines a flat container that stores all the boundary of a
+      /// binary image with index-based adjacencies.
+      typedef ::DGtal::FlatDigitalSurface< KSpace >               FlatSurfaceContainer;
+      /// defines a (connected or not) digital surface over a flat container.
+      typedef ::DGtal::DigitalSurface< FlatSurfaceContainer >     FlatDigitalSurface;
       typedef typename LightDigitalSurface::Surfel                Surfel;
       typedef typename LightDigitalSurface::Cell                  Cell;
       typedef typename LightDigitalSurface::SCell                 SCell;
@@ -639,6 +648,7 @@ namespace DGtal
       ///   - kernel          [ "hat"]: the kernel integration function chi_r, either "hat" or "ball". )
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - surfelEmbedding [     0]: the surfel -> point embedding for VCM estimator: 0: Pointels, 1: InnerSpel, 2: OuterSpel.
+      ///   - II-backend      ["convolver"]: the backend of II estimators, either "convolver", "SAT" (summed volume table, mean curvature only), "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       static Parameters parametersGeometryEstimation()
       {
         return Parameters
@@ -648,7 +658,8 @@ namespace DGtal
           ( "R-radius",       10.0 )
           ( "r-radius",        3.0 )
           ( "alpha",          0.33 )
-          ( "surfelEmbedding",   0 );
+          ( "surfelEmbedding",   0 )
+          ( "II-backend", "convolver" );
       }
 
       /// Given a digital space \a K and a vector of \a surfels,
@@ -832,6 +843,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated normals, in the
       /// same order as \a surfels.
@@ -867,6 +879,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///   - minAABB         [ -10.0]: the min value of the AABB bounding box (domain)
       ///   - maxAABB         [  10.0]: the max value of the AABB bounding box (domain)
       ///   - offset          [   5.0]: the digital dilation of the digital space,
@@ -908,6 +921,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated normals, in the
       /// same order as \a surfels.
@@ -945,6 +959,12 @@ namespace DGtal
             }
           IINormalFunctor     functor;
           functor.init( h, r*h );
+          if ( evalFFTIntegralInvariant( shape, K, surfels, functor, h, r, params,
+                                         std::back_inserter( n_estimations ) ) )
+            {
+              orientVectors( n_estimations, getTrivialNormalVectors( K, surfels ) );
+              return n_estimations;
+            }
           IINormalEstimator   ii_estimator( functor );
           ii_estimator.attach( K, shape );
           ii_estimator.setParams( r );
@@ -969,6 +989,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "SAT" (summed volume table), "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated mean curvatures, in the
       /// same order as \a surfels.
@@ -1000,6 +1021,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "SAT" (summed volume table), "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///   - minAABB         [ -10.0]: the min value of the AABB bounding box (domain)
       ///   - maxAABB         [  10.0]: the max value of the AABB bounding box (domain)
       ///   - offset          [   5.0]: the digital dilation of the digital space,
@@ -1039,6 +1061,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "SAT" (summed volume table), "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated mean curvatures, in the
       /// same order as \a surfels.
@@ -1057,6 +1080,8 @@ namespace DGtal
           typedef functors::IIMeanCurvature3DFunctor<Space> IIMeanCurvFunctor;
           typedef IntegralInvariantVolumeEstimator
             <KSpace, TPointPredicate, IIMeanCurvFunctor>    IIMeanCurvEstimator;
+          typedef IntegralInvariantSATVolumeEstimator
+            <KSpace, TPointPredicate, IIMeanCurvFunctor>    IIMeanCurvSATEstimator;
 
           Scalars  mc_estimations;
           int      verbose = params[ "verbose"   ].as<int>();
@@ -1072,6 +1097,20 @@ namespace DGtal
             }
           IIMeanCurvFunctor   functor;
           functor.init( h, r*h );
+          if ( evalFFTIntegralInvariant( shape, K, surfels, functor, h, r, params,
+                                         std::back_inserter( mc_estimations ), true ) )
+            return mc_estimations;
+          if ( params.count( "II-backend" )
+               && params[ "II-backend" ].as<std::string>() == "SAT" )
+            {
+              IIMeanCurvSATEstimator ii_estimator( functor );
+              ii_estimator.attach( K, shape );
+              ii_estimator.setParams( r );
+              ii_estimator.init( h, surfels.begin(), surfels.end() );
+              ii_estimator.eval( surfels.begin(), surfels.end(),
+                                 std::back_inserter( mc_estimations ) );
+              return mc_estimations;
+            }
           IIMeanCurvEstimator ii_estimator( functor );
           ii_estimator.attach( K, shape );
           ii_estimator.setParams( r );
@@ -1093,6 +1132,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated Gaussian curvatures, in the
       /// same order as \a surfels.
@@ -1124,6 +1164,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///   - minAABB         [ -10.0]: the min value of the AABB bounding box (domain)
       ///   - maxAABB         [  10.0]: the max value of the AABB bounding box (domain)
       ///   - offset          [   5.0]: the digital dilation of the digital space,
@@ -1163,6 +1204,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated Gaussian curvatures, in the
       /// same order as \a surfels.
@@ -1196,6 +1238,9 @@ namespace DGtal
             }
           IIGaussianCurvFunctor   functor;
           functor.init( h, r*h );
+          if ( evalFFTIntegralInvariant( shape, K, surfels, functor, h, r, params,
+                                         std::back_inserter( mc_estimations ) ) )
+            return mc_estimations;
           IIGaussianCurvEstimator ii_estimator( functor );
           ii_estimator.attach( K, shape );
           ii_estimator.setParams( r );
@@ -1218,6 +1263,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated Gaussian curvatures, in the
       /// same order as \a surfels.
@@ -1250,6 +1296,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///   - minAABB         [ -10.0]: the min value of the AABB bounding box (domain)
       ///   - maxAABB         [  10.0]: the max value of the AABB bounding box (domain)
       ///   - offset          [   5.0]: the digital dilation of the digital space,
@@ -1289,6 +1336,7 @@ namespace DGtal
       ///   - r-radius        [   3.0]: the constant for kernel radius parameter r in r(h)=r h^alpha (VCM,II,Trivial).
       ///   - alpha           [  0.33]: the parameter alpha in r(h)=r h^alpha (VCM, II)."
       ///   - gridstep        [   1.0]: the digitization gridstep (often denoted by h).
+      ///   - II-backend      ["convolver"]: the backend of the II estimator, either "convolver", "FFT" or "auto" (FFT when expected to be faster, requires FFTW3).
       ///
       /// @return the vector containing the estimated principal curvatures and directions,
       ///  in the same order as \a surfels.
@@ -1321,6 +1369,9 @@ namespace DGtal
         }
         IICurvFunctor   functor;
         functor.init( h, r*h );
+        if ( evalFFTIntegralInvariant( shape, K, surfels, functor, h, r, params,
+                                       std::back_inserter( mc_estimations ) ) )
+          return mc_estimations;
         IICurvEstimator ii_estimator( functor );
         ii_estimator.attach( K, shape );
         ii_estimator.setParams( r );
@@ -1809,6 +1860,79 @@ namespace DGtal
       // ------------------------- Hidden services ------------------------------
     protected:
 
+      /// Evaluates an Integral Invariant functor at the specified \a
+      /// surfels with IntegralInvariantFFTEstimator, when the
+      /// "II-backend" parameter is "FFT", or "auto" and the FFT is
+      /// expected to be faster than the per-surfel convolver. An
+      /// unknown "II-backend" value is reported with a warning and the
+      /// convolver is used.
+      ///
+      /// @tparam TPointPredicate any type of map Point -> boolean.
+      /// @tparam TIIFunctor the type of Integral Invariant functor (volume or covariance matrix).
+      /// @tparam TOutputIterator the type of output iterator on the functor quantities.
+      ///
+      /// @param[in] shape a function Point -> boolean telling if you are inside the shape.
+      /// @param[in] K the Khalimsky space where the shape and surfels live.
+      /// @param[in] surfels the sequence of surfels at which we compute the quantities.
+      /// @param[in] functor the initialized Integral Invariant functor.
+      /// @param[in] h the gridstep.
+      /// @param[in] r the digital radius of the kernel.
+      /// @param[in] params the parameters (II-backend).
+      /// @param[out] out the output iterator on the quantities.
+      /// @param[in] withSAT when 'true', "SAT" is a valid backend for the caller.
+      ///
+      /// @return 'true' if the quantities have been computed, 'false' if
+      /// the per-surfel convolver (or the SAT estimator) must be used.
+      template <typename TPointPredicate, typename TIIFunctor, typename TOutputIterator>
+        static bool
+        evalFFTIntegralInvariant( const TPointPredicate& shape,
+                                  const KSpace&          K,
+                                  const SurfelRange&     surfels,
+                                  const TIIFunctor&      functor,
+                                  Scalar h, Scalar r,
+                                  const Parameters&      params,
+                                  TOutputIterator        out,
+                                  bool withSAT = false )
+        {
+          const std::string backend = params.count( "II-backend" )
+            ? params[ "II-backend" ].as<std::string>() : "convolver";
+          if ( backend != "FFT" && backend != "auto" )
+            {
+              if ( backend == "SAT" && ! withSAT )
+                trace.warning() << "[ShortcutsGeometry] II-backend SAT is only available for mean curvatures, using the convolver."
+                                << std::endl;
+              else if ( backend != "convolver" && backend != "SAT" )
+                trace.warning() << "[ShortcutsGeometry] Unknown II-backend \"" << backend
+                                << "\" (should be convolver, SAT, FFT or auto), using the convolver."
+                                << std::endl;
+              return false;
+            }
+#ifdef WITH_FFTW3
+          typedef IntegralInvariantFFTEstimator
+            <KSpace, TPointPredicate, TIIFunctor>            IIFFTEstimator;
+          if ( backend == "auto"
+               && ! IIFFTEstimator::isFasterThanConvolver( K, surfels.size(), r ) )
+            return false;
+          IIFFTEstimator ii_estimator( K, shape, functor );
+          ii_estimator.setParams( r );
+          ii_estimator.init( h, surfels.begin(), surfels.end() );
+          ii_estimator.eval( surfels.begin(), surfels.end(), out );
+          return true;
+#else
+          boost::ignore_unused_variable_warning( shape );
+          boost::ignore_unused_variable_warning( K );
+          boost::ignore_unused_variable_warning( surfels );
+          boost::ignore_unused_variable_warning( functor );
+          boost::ignore_unused_variable_warning( h );
+          boost::ignore_unused_variable_warning( r );
+          boost::ignore_unused_variable_warning( out );
+          if ( backend == "FFT" )
+            trace.warning() << "[ShortcutsGeometry] II-backend FFT requires FFTW3 (WITH_FFTW3), using the convolver."
+                            << std::endl;
+          return false;
+#endif
+        }
+
       // ------------------------- Internals ------------------------------------
     private:
 
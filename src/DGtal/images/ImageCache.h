@@ -41,6 +41,12 @@
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include "DGtal/base/Common.h"
 #include "DGtal/base/ConceptUtils.h"
 #include "DGtal/images/CImage.h"
@@ -72,6 +78,21 @@ namespace DGtal
  *  - read :    for getting the value of an image from cache at a given position given by a point only if that point belongs to an image from cache
  *  - write :   for setting a   value on an image from cache at a given position given by a point only if that point belongs to an image from cache
  *  - update :  for updating the cache according to the read cache policy
+ *
+ * The cache may be shared by several threads. Reading a value in a
+ * cached page only takes a shared lock, while loading a page (with the
+ * eviction of another one), writing a value or clearing the cache take
+ * an exclusive lock, so that a page is never detached while another
+ * thread reads it. Policies are thus only required to support
+ * concurrent calls to getPage, as ImageCacheReadPolicyLRU does. Since
+ * another thread may evict a page just after it was loaded, use
+ * updateAndRead and updateAndWrite rather than update followed by
+ * read or write, and do not keep the pointers returned by getPage
+ * while other threads may update the cache.
+ *
+ * Pages may also be loaded asynchronously with prefetch, by a
+ * background thread started at the first call. The numbers of hits,
+ * misses, evictions and prefetched pages are counted.
  */
 template <typename TImageContainer, typename TImageFactory, typename TReadPolicy, typename TWritePolicy>
 class ImageCache
@@ -110,21 +131,18 @@ public:
      * @param aWritePolicy a write policy.
      */
     ImageCache(Alias<ImageFactory> anImageFactory, Alias<ReadPolicy> aReadPolicy, Alias<WritePolicy> aWritePolicy):
-      myImageFactoryPtr(&anImageFactory), myReadPolicy(&aReadPolicy), myWritePolicy(&aWritePolicy)
+      myImageFactoryPtr(&anImageFactory), myReadPolicy(&aReadPolicy), myWritePolicy(&aWritePolicy),
+      cacheMissRead(0), cacheMissWrite(0), myCacheHits(0), myEvictions(0), myPrefetches(0),
+      myPrefetchStop(false), myPrefetchBusy(false)
     {
       myReadPolicy->clearCache();
-      
-      cacheMissRead = 0;
-      cacheMissWrite = 0;
     }
     
     /**
      * Destructor.
-     * Does nothing
+     * Stops the prefetching thread, dropping pending prefetches.
      */
-    ~ImageCache()
-    {
-    }
+    ~ImageCache();
     
 private:
     
@@ -169,6 +187,16 @@ public:
     */
     bool read(const Point & aPoint, Value &aValue) const;
     
+    /**
+     * Update the cache with the page of domain aDomain, if it is not
+     * already in the cache, then get the value at aPoint, atomically.
+     *
+     * @param aDomain the domain of the page.
+     * @param aPoint a point of aDomain.
+     * @param aValue the value returned.
+     */
+    void updateAndRead(const Domain & aDomain, const Point & aPoint, Value &aValue);
+    
     /**
      * Get the alias on the image that matchs the domain aDomain
      * or NULL if no image in the cache matchs the domain aDomain.
@@ -190,6 +218,16 @@ public:
      */
     bool write(const Point & aPoint, const Value &aValue);
     
+    /**
+     * Update the cache with the page of domain aDomain, if it is not
+     * already in the cache, then set the value at aPoint, atomically.
+     *
+     * @param aDomain the domain of the page.
+     * @param aPoint a point of aDomain.
+     * @param aValue the value.
+     */
+    void updateAndWrite(const Domain & aDomain, const Point & aPoint, const Value &aValue);
+    
     /**
      * Update the cache according to the read cache policy.
      * 
@@ -197,10 +235,24 @@ public:
      */
     void update(const Domain &aDomain);
     
+    /**
+     * Ask the background thread to update the cache with the page of
+     * domain aDomain, if it is not in the cache at that time. Returns
+     * immediately.
+     *
+     * @param aDomain the domain.
+     */
+    void prefetch(const Domain &aDomain);
+    
+    /**
+     * Wait until all the pages asked with prefetch are in the cache.
+     */
+    void waitPrefetches();
+    
     /**
      * Get the cacheMissRead value.
      */
-    unsigned int getCacheMissRead()
+    unsigned int getCacheMissRead() const
     {
         return cacheMissRead;
     }
@@ -208,11 +260,35 @@ public:
     /**
      * Get the cacheMissWrite value.
      */
-    unsigned int getCacheMissWrite()
+    unsigned int getCacheMissWrite() const
     {
         return cacheMissWrite;
     }
     
+    /**
+     * Get the number of successful reads.
+     */
+    unsigned long getCacheHits() const
+    {
+        return myCacheHits;
+    }
+    
+    /**
+     * Get the number of pages detached to make room for other ones.
+     */
+    unsigned long getCacheEvictions() const
+    {
+        return myEvictions;
+    }
+    
+    /**
+     * Get the number of pages loaded by the prefetching thread.
+     */
+    unsigned long getCachePrefetches() const
+    {
+        return myPrefetches;
+    }
+    
     /**
      * Inc the cacheMissRead value.
      */
@@ -230,15 +306,10 @@ public:
     }
     
     /**
-     * Clear the cache and reset the cache misses
+     * Clear the cache and reset the cache misses (and the other counters).
+     * Pending prefetches are dropped.
      */
-    void clearCacheAndResetCacheMisses()
-    {
-      myReadPolicy->clearCache();
-      
-      cacheMissRead = 0;
-      cacheMissWrite = 0;
-    }
+    void clearCacheAndResetCacheMisses();
 
     // ------------------------- Protected Datas ------------------------------
 private:
@@ -258,13 +329,48 @@ protected:
     WritePolicy * myWritePolicy;
     
 private:
-    
     /// cache miss values
-    unsigned int cacheMissRead;
-    unsigned int cacheMissWrite;
-
+    std::atomic<unsigned int> cacheMissRead;
+    std::atomic<unsigned int> cacheMissWrite;
+    /// number of successful reads
+    mutable std::atomic<unsigned long> myCacheHits;
+    /// number of detached pages
+    std::atomic<unsigned long> myEvictions;
+    /// number of pages loaded by the prefetching thread
+    std::atomic<unsigned long> myPrefetches;
+    
+    /// Shared for reading values in pages, exclusive for changing pages.
+    mutable std::shared_mutex myMutex;
+    
+    /// Protects the prefetch queue and flags.
+    std::mutex myPrefetchMutex;
+    /// Signals new prefetches, and the end of prefetches.
+    std::condition_variable myPrefetchCondition;
+    /// Domains of the pages to prefetch.
+    std::deque<Domain> myPrefetchQueue;
+    /// The prefetching thread, started at the first prefetch.
+    std::thread myPrefetchThread;
+    /// When 'true', the prefetching thread stops.
+    bool myPrefetchStop;
+    /// When 'true', the prefetching thread is loading a page.
+    bool myPrefetchBusy;
+    
     // ------------------------- Internals ------------------------------------
 private:
+    
+    /**
+     * Update the cache with the page of domain aDomain, unless it is
+     * already in the cache. The exclusive lock must be held.
+     *
+     * @param aDomain the domain.
+     * @return 'true' if the page was loaded.
+     */
+    bool updateLocked(const Domain &aDomain);
+    
+    /**
+     * Loop of the prefetching thread.
+     */
+    void prefetchLoop();
 
 }; // end of class ImageCache
 
@@ -41,6 +41,9 @@
 //////////////////////////////////////////////////////////////////////////////
 // Inclusions
 #include <iostream>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include "DGtal/base/Common.h"
 #include "DGtal/base/ConceptUtils.h"
 #include "DGtal/images/CImage.h"
@@ -266,6 +269,144 @@ protected:
     
 }; // end of class ImageCacheReadPolicyFIFO
 
+/////////////////////////////////////////////////////////////////////////////
+// Template class ImageCacheReadPolicyLRU
+/**
+ * Description of template class 'ImageCacheReadPolicyLRU' <p>
+ * \brief Aim: implements a 'LRU' read policy cache.
+ * 
+ * The cache keeps at most a given number of pages in memory. When a page needs to be replaced, 
+ * the least recently used page is selected.
+ * 
+ * Pages are dated with a clock that ticks at each page loading, so that pages used since the last 
+ * loading are considered as recent as the last loaded page. Dates are atomic, so that getPage 
+ * may be called concurrently by several threads, without lock, as done by ImageCache. The 
+ * last page found is checked first.
+ * 
+ * @tparam TImageContainer an image container type (model of CImage).
+ * @tparam TImageFactory an image factory.
+ * 
+ * The policy is done with 5 functions:
+ * 
+ *  - getPage :                 for getting the alias on the image that contains a point or NULL if no image in the cache contains that point
+ *  - getPage :                 for getting the alias on the image that contains a domain or NULL if no image in the cache contains that domain
+ *  - getPageToDetach :         for getting the alias on the image that we have to detach or NULL if no image have to be detached
+ *  - updateCache :             for updating the cache according to the cache policy
+ *  - clearCache :              for clearing the cache
+ */
+template <typename TImageContainer, typename TImageFactory>
+class ImageCacheReadPolicyLRU
+{
+public:
+    
+    ///Checking concepts
+    BOOST_CONCEPT_ASSERT(( concepts::CImage<TImageContainer> ));
+    BOOST_CONCEPT_ASSERT(( concepts::CImageFactory<TImageFactory> ));    
+
+    typedef TImageFactory ImageFactory;
+    typedef TImageContainer ImageContainer;
+    typedef typename TImageContainer::Domain Domain;
+    typedef typename TImageContainer::Point Point;
+    typedef typename TImageContainer::Value Value;
+
+    ImageCacheReadPolicyLRU(Alias<ImageFactory> anImageFactory, unsigned int aCacheSizeMax=10):
+       myCacheSizeMax(aCacheSizeMax), myPages(new Page[aCacheSizeMax]), myClock(0), myLastPage(0),
+       myImageFactory(&anImageFactory)
+    {
+      ASSERT(aCacheSizeMax > 0);
+      clearCache();
+    }
+
+    /**
+     * Destructor.
+     * Does nothing
+     */
+    ~ImageCacheReadPolicyLRU() {}
+    
+private:
+  
+    ImageCacheReadPolicyLRU( const ImageCacheReadPolicyLRU & other );
+    ImageCacheReadPolicyLRU & operator=( const ImageCacheReadPolicyLRU & other );
+    
+public:
+  
+    /**
+     * Get the alias on the image that contains the point aPoint
+     * or NULL if no image in the cache contains the point aPoint.
+     * The page is marked as used.
+     * 
+     * @param aPoint the point.
+     *
+     * @return the alias on the image container or NULL pointer.
+     */
+    ImageContainer * getPage(const Point & aPoint);
+    
+    /**
+     * Get the alias on the image that matchs the domain aDomain
+     * or NULL if no image in the cache matchs the domain aDomain.
+     * The page is marked as used.
+     * 
+     * @param aDomain the domain.
+     *
+     * @return the alias on the image container or NULL pointer.
+     */
+    ImageContainer * getPage(const Domain & aDomain);
+    
+    /**
+     * Get the alias on the image that we have to detach
+     * or NULL if no image have to be detached.
+     *
+     * @return the alias on the image container or NULL pointer.
+     */
+    ImageContainer * getPageToDetach();
+    
+    /**
+     * Update the cache according to the cache policy.
+     *
+     * @param aDomain the domain.
+     */
+    void updateCache(const Domain &aDomain);
+    
+    /**
+     * Clear the cache.
+     */
+    void clearCache();
+    
+protected:
+    
+    /// A page of the cache.
+    struct Page
+    {
+      /// Alias on the image, or NULL for a free page.
+      ImageContainer * image;
+      /// Date of the last use.
+      std::atomic<unsigned long> lastUse;
+    };
+    
+    /**
+     * Mark a page as used.
+     *
+     * @param anIndex the index of the page.
+     */
+    void touch(unsigned int anIndex);
+    
+    /// Size max of the cache
+    unsigned int myCacheSizeMax;
+    
+    /// The pages of the cache
+    std::unique_ptr<Page[]> myPages;
+    
+    /// The clock, incremented at each page loading
+    std::atomic<unsigned long> myClock;
+    
+    /// The index of the last page found
+    std::atomic<unsigned int> myLastPage;
+    
+    /// Alias on the image factory
+    ImageFactory * myImageFactory;
+    
+}; // end of class ImageCacheReadPolicyLRU
+
 /////////////////////////////////////////////////////////////////////////////
 // Template class ImageCacheWritePolicyWT
 /**
@@ -0,0 +1,299 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file ImageContainerByBricks.h
+ *
+ * Header file for module ImageContainerByBricks.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(ImageContainerByBricks_RECURSES)
+#error Recursive header files inclusion detected in ImageContainerByBricks.h
+#else // defined(ImageContainerByBricks_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define ImageContainerByBricks_RECURSES
+
+#if !defined ImageContainerByBricks_h
+/** Prevents repeated inclusion of headers. */
+#define ImageContainerByBricks_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <array>
+#include <string>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/CLabel.h"
+#include "DGtal/kernel/domains/CDomain.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+#include "DGtal/kernel/domains/Linearizer.h"
+#include "DGtal/images/DefaultConstImageRange.h"
+#include "DGtal/images/DefaultImageRange.h"
+#include "DGtal/images/SetValueIterator.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class ImageContainerByBricks
+  /**
+   * Description of template class 'ImageContainerByBricks' <p>
+   *
+   * \brief Aim: Model of CImage implementing a dense image whose values
+   * are stored by bricks, so that neighbor points are close in memory
+   * along every axis.
+   *
+   * The domain is cut into bricks of \f$ 2^{TLogBrickSize} \f$ points
+   * along each axis (8x8x8 points by default in 3D), and the values of
+   * each brick are stored contiguously (see BrickedStorage and the
+   * corresponding Linearizer). Contrary to ImageContainerBySTLVector,
+   * where the neighbors of a point along the last axis are a whole
+   * slice away, the 26 neighbors of a point lie in at most 8 bricks,
+   * which keeps neighborhood accesses (convolution kernels, digital
+   * topology, distance transformation passes along any axis) in cache.
+   *
+   * Bricks at the upper border of the domain are stored entirely, so
+   * the memory size is the one of the domain rounded up to a multiple
+   * of the brick size along each axis. Iterating over the points of
+   * each brick (see brickDomain()) visits values in memory order.
+   *
+   * @tparam TDomain a HyperRectDomain.
+   * @tparam TValue at least a model of CLabel.
+   * @tparam TLogBrickSize the base 2 logarithm of the brick size.
+   *
+   * @see testImageContainerByBricks.cpp
+   * @see benchmarkImageContainer.cpp
+   */
+  template <typename TDomain, typename TValue, unsigned int TLogBrickSize = 3>
+  class ImageContainerByBricks
+  {
+  public:
+    typedef ImageContainerByBricks<TDomain, TValue, TLogBrickSize> Self;
+
+    /// domain
+    BOOST_CONCEPT_ASSERT ( ( concepts::CDomain<TDomain> ) );
+    typedef TDomain Domain;
+    typedef typename Domain::Point Point;
+    typedef typename Domain::Vector Vector;
+    typedef typename Domain::Integer Integer;
+    typedef typename Domain::Size Size;
+    typedef typename Domain::Dimension Dimension;
+    typedef Point Vertex;
+
+    BOOST_STATIC_CONSTANT( Dimension, dimension = Domain::Space::dimension );
+
+    /// domain should be rectangular
+    BOOST_STATIC_ASSERT ( ( boost::is_same< Domain,
+                            HyperRectDomain< typename Domain::Space > >::value ) );
+
+    /// range of values
+    BOOST_CONCEPT_ASSERT ( ( concepts::CLabel<TValue> ) );
+    typedef TValue Value;
+    typedef DefaultConstImageRange<Self> ConstRange;
+    typedef DefaultImageRange<Self> Range;
+
+    /// output iterator
+    typedef SetValueIterator<Self> OutputIterator;
+
+    /// The container of values, in brick order.
+    typedef std::vector<Value> Container;
+    /// The linearizer giving the index of each point.
+    typedef Linearizer< Domain, BrickedStorage<TLogBrickSize> > BrickLinearizer;
+
+    /////////////////// standard services //////////////////
+  public:
+
+    /**
+     * Constructor from a Domain.
+     *
+     * @param aDomain the image domain.
+     * @param aValue the initial value of all the points.
+     */
+    ImageContainerByBricks( const Domain & aDomain, const Value & aValue = Value() );
+
+    /////////////////// CImage interface //////////////////
+  public:
+
+    /**
+     * Get the value of an image at a given position.
+     *
+     * @pre the point must be in the domain
+     * @param aPoint the point.
+     * @return the value at aPoint.
+     */
+    Value operator()( const Point & aPoint ) const;
+
+    /**
+     * Set a value on an Image at a given position.
+     *
+     * @pre the point must be in the domain
+     * @param aPoint the point.
+     * @param aValue the value.
+     */
+    void setValue( const Point & aPoint, const Value & aValue );
+
+    /// @return the domain associated to the image.
+    const Domain & domain() const;
+
+    /// @return the extent of the image domain.
+    const Vector & extent() const;
+
+    /// @return the const range providing constant iterators to
+    /// iterate over the values of the image.
+    ConstRange constRange() const;
+
+    /// @return the range providing constant iterators and output
+    /// iterators on the values of the image.
+    Range range();
+
+    /// @return an output iterator writing values in the domain order.
+    OutputIterator outputIterator();
+
+    /////////////////// Brick services //////////////////
+  public:
+
+    /// @return the number of points of a brick along each axis.
+    static Size brickSize();
+
+    /// @return the number of bricks covering the domain.
+    Size nbBricks() const;
+
+    /// @param aBrick the index of a brick, between 0 and nbBricks()-1.
+    /// @return the points of this brick that lie in the domain, whose
+    /// values are contiguous in the container (in the domain order).
+    Domain brickDomain( Size aBrick ) const;
+
+    /// @param aPoint any point of the domain.
+    /// @return the index of its value in the container.
+    Size linearized( const Point & aPoint ) const;
+
+    /// @param anIndex the index of a value in the container.
+    /// @return the corresponding point (possibly outside the domain in
+    /// bricks at the upper border).
+    Point point( Size anIndex ) const;
+
+    /// @return the container of values, in brick order.
+    const Container & container() const;
+
+    /// @return the container of values, in brick order.
+    Container & container();
+
+    /////////////////// Neighborhood services //////////////////
+  public:
+
+    /**
+     * Displacements of a neighborhood (e.g. the 26 neighbors of a 3D
+     * point) with their offsets in the container, valid when the
+     * displaced points lie in the same brick as the center.
+     */
+    struct Neighborhood
+    {
+      /// The displacements of the neighbors.
+      std::vector<Vector> displacements;
+      /// The corresponding offsets in the container within a brick.
+      std::vector<std::ptrdiff_t> offsets;
+      /// The greatest absolute coordinate of the displacements.
+      Integer radius;
+    };
+
+    /// @param aDisplacements the displacements of the neighbors, whose
+    /// coordinates are smaller than brickSize() in absolute value.
+    /// @return the neighborhood with its precomputed offsets.
+    static Neighborhood neighborhood( const std::vector<Vector> & aDisplacements );
+
+    /**
+     * Writes the values of the neighbors of a point, in the order of
+     * the displacements of @a aNeighborhood. If the whole neighborhood
+     * lies in the brick of @a aPoint, values are read at the
+     * precomputed offsets. Otherwise, the offsets along each axis are
+     * computed once for the point, instead of linearizing each neighbor.
+     *
+     * @pre the neighbors of @a aPoint must be in the domain.
+     * @tparam TOutputIterator any output iterator on Value.
+     * @param aPoint any point.
+     * @param aNeighborhood a neighborhood built with neighborhood().
+     * @param out the output iterator, incremented for each neighbor.
+     */
+    template <typename TOutputIterator>
+    void writeNeighborValues( const Point & aPoint,
+                              const Neighborhood & aNeighborhood,
+                              TOutputIterator & out ) const;
+
+    /////////////////// Interface //////////////////
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    /**
+     * @return the style name used for drawing this object.
+     */
+    std::string className() const;
+
+    /////////////////// Data members //////////////////
+  private:
+    /// Image domain
+    Domain myDomain;
+    /// Domain extent (stored for linearization efficiency)
+    Vector myExtent;
+    /// The values, brick after brick.
+    Container myValues;
+    /// For each axis, the offset between the values of consecutive bricks.
+    std::array<Size, dimension> myBrickStrides;
+
+  }; // end of class ImageContainerByBricks
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'ImageContainerByBricks'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'ImageContainerByBricks' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TDomain, typename TValue, unsigned int TLogBrickSize>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const ImageContainerByBricks<TDomain, TValue, TLogBrickSize> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/images/ImageContainerByBricks.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined ImageContainerByBricks_h
+
+#undef ImageContainerByBricks_RECURSES
+#endif // else defined(ImageContainerByBricks_RECURSES)
@@ -0,0 +1,323 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file ImageContainerByPackedBits.h
+ *
+ * Header file for module ImageContainerByPackedBits.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(ImageContainerByPackedBits_RECURSES)
+#error Recursive header files inclusion detected in ImageContainerByPackedBits.h
+#else // defined(ImageContainerByPackedBits_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define ImageContainerByPackedBits_RECURSES
+
+#if !defined ImageContainerByPackedBits_h
+/** Prevents repeated inclusion of headers. */
+#define ImageContainerByPackedBits_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <string>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/kernel/domains/CDomain.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+#include "DGtal/images/DefaultConstImageRange.h"
+#include "DGtal/images/DefaultImageRange.h"
+#include "DGtal/images/SetValueIterator.h"
+#include "DGtal/topology/helpers/NeighborhoodConfigurationsHelper.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class ImageContainerByPackedBits
+  /**
+   * Description of template class 'ImageContainerByPackedBits' <p>
+   *
+   * \brief Aim: Model of CImage implementing a binary image, where
+   * values are packed as bits into 64-bit words.
+   *
+   * Points are linearized as in ImageContainerBySTLVector (first
+   * coordinate first), but each row of the domain along the first axis
+   * starts at a new word, so that a row is a contiguous range of
+   * wordsPerRow() words. Bits of a word follow increasing first
+   * coordinates, from the least significant bit. Padding bits at the
+   * end of each row are always 0.
+   *
+   * Besides the CImage services, the words can be read (and written)
+   * directly, and the class provides word-level services: counting
+   * true values (in the whole image or in a box), bitwise and/or/xor
+   * with another image on the same domain, complementation, parallel
+   * filling from a point predicate (e.g. a threshold of another image)
+   * and the extraction of the configuration of the 8- or
+   * 26-neighborhood of a point as a bit mask, which can be given
+   * directly to the tables of NeighborhoodTables.h (e.g. to check the
+   * simplicity of a point).
+   *
+   * \code
+   * ImageContainerByPackedBits< Z3i::Domain > image( domain );
+   * image.setFromPredicate( [&] ( const Z3i::Point & p ) { return grey( p ) > 128; } );
+   * auto table = functions::loadTable( simplicity::tableSimple26_6 );
+   * bool simple = (*table)[ image.getNeighborhoodConfiguration( p ) ];
+   * \endcode
+   *
+   * @tparam TDomain a HyperRectDomain.
+   */
+  template <typename TDomain>
+  class ImageContainerByPackedBits
+  {
+  public:
+    typedef ImageContainerByPackedBits<TDomain> Self;
+
+    /// domain
+    BOOST_CONCEPT_ASSERT ( ( concepts::CDomain<TDomain> ) );
+    typedef TDomain Domain;
+    typedef typename Domain::Point Point;
+    typedef typename Domain::Vector Vector;
+    typedef typename Domain::Integer Integer;
+    typedef typename Domain::Size Size;
+    typedef typename Domain::Dimension Dimension;
+    typedef Point Vertex;
+
+    BOOST_STATIC_CONSTANT( Dimension, dimension = Domain::Space::dimension );
+
+    /// domain should be rectangular
+    BOOST_STATIC_ASSERT ( ( boost::is_same< Domain,
+                            HyperRectDomain< typename Domain::Space > >::value ) );
+
+    /// range of values
+    typedef bool Value;
+    typedef DefaultConstImageRange<Self> ConstRange;
+    typedef DefaultImageRange<Self> Range;
+
+    /// output iterator
+    typedef SetValueIterator<Self> OutputIterator;
+
+    /// The type of words storing the bits.
+    typedef DGtal::uint64_t Word;
+    /// The number of bits of a word.
+    BOOST_STATIC_CONSTANT( unsigned int, wordBits = 64 );
+
+    /////////////////// standard services //////////////////
+  public:
+
+    /**
+     * Constructor from a Domain.
+     *
+     * @param aDomain the image domain.
+     * @param aValue the initial value of all the points.
+     */
+    ImageContainerByPackedBits( const Domain & aDomain, Value aValue = false );
+
+    /////////////////// CImage interface //////////////////
+  public:
+
+    /**
+     * Get the value of an image at a given position.
+     *
+     * @pre the point must be in the domain
+     * @param aPoint the point.
+     * @return the value at aPoint.
+     */
+    Value operator()( const Point & aPoint ) const;
+
+    /**
+     * Set a value on an Image at a given position.
+     *
+     * @pre the point must be in the domain
+     * @param aPoint the point.
+     * @param aValue the value.
+     */
+    void setValue( const Point & aPoint, Value aValue );
+
+    /// @return the domain associated to the image.
+    const Domain & domain() const;
+
+    /// @return the extent of the image domain.
+    const Vector & extent() const;
+
+    /// @return the const range providing constant iterators to
+    /// iterate over the values of the image.
+    ConstRange constRange() const;
+
+    /// @return the range providing constant iterators and output
+    /// iterators on the values of the image.
+    Range range();
+
+    /// @return an output iterator writing values in the domain order.
+    OutputIterator outputIterator();
+
+    /////////////////// Word services //////////////////
+  public:
+
+    /// @return the words storing the image, row after row.
+    const std::vector<Word> & words() const;
+
+    /// @return the words storing the image, row after row.
+    /// @note padding bits at the end of rows must be left to 0.
+    std::vector<Word> & words();
+
+    /// @return the number of words of each row along the first axis.
+    Size wordsPerRow() const;
+
+    /// @return the number of rows along the first axis.
+    Size nbRows() const;
+
+    /// @param aPoint any point of the domain.
+    /// @return the index of the row containing \a aPoint, i.e. its
+    /// words begin at `rowIndex( aPoint ) * wordsPerRow()`.
+    Size rowIndex( const Point & aPoint ) const;
+
+    /// Sets all the values of the image.
+    /// @param aValue the value.
+    void fill( Value aValue );
+
+    /// Sets the value of each point to the value of a predicate. Rows
+    /// are processed in parallel when DGtal is built with OpenMP.
+    ///
+    /// @tparam TPointPredicate any point predicate (e.g. a threshold
+    /// of another image).
+    /// @param aPredicate the predicate, which must be callable from several threads.
+    template <typename TPointPredicate>
+    void setFromPredicate( const TPointPredicate & aPredicate );
+
+    /// Complements the image.
+    void flip();
+
+    /// @return the number of points with value true.
+    Size count() const;
+
+    /// @param lower the lowest point of a box.
+    /// @param upper the uppest point of a box.
+    /// @return the number of points with value true in the box (cut by
+    /// the domain).
+    Size count( const Point & lower, const Point & upper ) const;
+
+    /// Intersection with another image on the same domain.
+    /// @param other any image with the same domain.
+    /// @return a reference to this.
+    Self & operator&=( const Self & other );
+
+    /// Union with another image on the same domain.
+    /// @param other any image with the same domain.
+    /// @return a reference to this.
+    Self & operator|=( const Self & other );
+
+    /// Symmetric difference with another image on the same domain.
+    /// @param other any image with the same domain.
+    /// @return a reference to this.
+    Self & operator^=( const Self & other );
+
+    /// Computes the configuration of the neighborhood of a point, in
+    /// the format of NeighborhoodConfigurations.h (one bit per
+    /// neighbor in lexicographic order, the point excluded). Points
+    /// outside the domain are considered false. Only for dimension 2
+    /// (8-neighborhood) and 3 (26-neighborhood).
+    ///
+    /// @param aPoint any point of the domain.
+    /// @return the configuration of its neighborhood.
+    NeighborhoodConfiguration getNeighborhoodConfiguration( const Point & aPoint ) const;
+
+    /// @param w any word.
+    /// @return the number of its bits equal to 1.
+    static unsigned int popcount( Word w );
+
+    /////////////////// Interface //////////////////
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    /**
+     * @return the style name used for drawing this object.
+     */
+    std::string className() const;
+
+    /////////////////// Data members //////////////////
+  private:
+    /// Image domain
+    Domain myDomain;
+    /// Domain extent
+    Vector myExtent;
+    /// Number of words of each row
+    Size myWordsPerRow;
+    /// Number of rows
+    Size myNbRows;
+    /// The bits of the image, row after row.
+    std::vector<Word> myWords;
+
+    /////////////////// Internals //////////////////
+  private:
+
+    /// @param first the first bit of a range of bits.
+    /// @param last the last bit (included) of a range of bits, in the same word.
+    /// @return the word with these bits set.
+    static Word bitMask( Size first, Size last );
+
+    /// Resets the padding bits at the end of each row to 0.
+    void clearPadding();
+
+    /// @param row the first word of a row.
+    /// @param x the index of a bit of the row, or -1.
+    /// @return the bits x-1, x and x+1 of the row (as bits 0, 1 and 2),
+    /// bits out of the row being 0.
+    Word threeBits( const Word * row, Integer x ) const;
+
+  }; // end of class ImageContainerByPackedBits
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'ImageContainerByPackedBits'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'ImageContainerByPackedBits' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TDomain>
+  std::ostream&
+  operator<< ( std::ostream & out, const ImageContainerByPackedBits<TDomain> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/images/ImageContainerByPackedBits.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined ImageContainerByPackedBits_h
+
+#undef ImageContainerByPackedBits_RECURSES
+#endif // else defined(ImageContainerByPackedBits_RECURSES)
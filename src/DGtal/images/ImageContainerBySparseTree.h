@@ -0,0 +1,503 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file ImageContainerBySparseTree.h
+ *
+ * Header file for module ImageContainerBySparseTree.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(ImageContainerBySparseTree_RECURSES)
+#error Recursive header files inclusion detected in ImageContainerBySparseTree.h
+#else // defined(ImageContainerBySparseTree_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define ImageContainerBySparseTree_RECURSES
+
+#if !defined ImageContainerBySparseTree_h
+/** Prevents repeated inclusion of headers. */
+#define ImageContainerBySparseTree_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/iterator/iterator_facade.hpp>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/CowPtr.h"
+#include "DGtal/base/CLabel.h"
+#include "DGtal/kernel/domains/CDomain.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
+#include "DGtal/images/DefaultConstImageRange.h"
+#include "DGtal/images/DefaultImageRange.h"
+#include "DGtal/images/SetValueIterator.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class ImageContainerBySparseTree
+  /**
+   * Description of template class 'ImageContainerBySparseTree' <p>
+   *
+   * \brief Aim: Model of CImage and CDigitalSet storing a sparse image
+   * in a shallow tree of dense bricks, in the spirit of VDB.
+   *
+   * Points are either active, with their own value, or inactive, with
+   * the background value of the image. Active points are stored in
+   * three levels:
+   *
+   * - the root is a hash map from tiles of \f$ 2^{N+L} \f$ points
+   *   along each axis to internal nodes,
+   * - an internal node is a dense array of \f$ 2^{dN} \f$ references
+   *   to leaves,
+   * - a leaf is a brick of \f$ 2^L \f$ points along each axis, with a
+   *   dense array of values and a bit mask of its active points.
+   *
+   * With the default parameters (L=3, N=4), a leaf holds 8x8x8 points
+   * and a tile 128x128x128 points in 3D. Memory is then proportional
+   * to the number of leaves touched by active points, whatever the
+   * size of the domain, and an access is one hash lookup and two array
+   * lookups. Leaves are stored contiguously, so that iterating over
+   * active points (the iterators of the set) scans leaves in memory
+   * order and skips inactive points word by word.
+   *
+   * Setting a point to the background value makes it inactive, so
+   * that the active points are exactly the points whose value is not
+   * the background. When \a TValue is bool (a binary image, the
+   * default), the image is also a model of CDigitalSet whose points are
+   * the active points, and may be used directly, e.g. with
+   * DigitalSetBoundary, or as a point predicate for
+   * LightImplicitDigitalSurface and Surfaces. Points inserted in the
+   * set take the foreground value given at construction.
+   *
+   * Erasing points never frees leaves, so that iterators remain valid;
+   * call prune() to release the leaves and nodes that became empty.
+   *
+   * @tparam TDomain a HyperRectDomain.
+   * @tparam TValue at least a model of CLabel, bool by default.
+   * @tparam TLogLeafSize the base 2 logarithm of the leaf size.
+   * @tparam TLogNodeSize the base 2 logarithm of the number of leaves
+   * of an internal node along each axis.
+   *
+   * @see testImageContainerBySparseTree.cpp
+   */
+  template <typename TDomain, typename TValue = bool,
+            unsigned int TLogLeafSize = 3, unsigned int TLogNodeSize = 4>
+  class ImageContainerBySparseTree
+  {
+  public:
+    typedef ImageContainerBySparseTree<TDomain, TValue, TLogLeafSize, TLogNodeSize> Self;
+
+    /// domain
+    BOOST_CONCEPT_ASSERT ( ( concepts::CDomain<TDomain> ) );
+    typedef TDomain Domain;
+    typedef typename Domain::Space Space;
+    typedef typename Domain::Point Point;
+    typedef typename Domain::Vector Vector;
+    typedef typename Domain::Integer Integer;
+    typedef typename Domain::Size Size;
+    typedef typename Domain::Dimension Dimension;
+    typedef Point Vertex;
+
+    BOOST_STATIC_CONSTANT( Dimension, dimension = Domain::Space::dimension );
+
+    /// domain should be rectangular
+    BOOST_STATIC_ASSERT ( ( boost::is_same< Domain,
+                            HyperRectDomain< typename Domain::Space > >::value ) );
+
+    /// range of values
+    BOOST_CONCEPT_ASSERT ( ( concepts::CLabel<TValue> ) );
+    typedef TValue Value;
+    typedef DefaultConstImageRange<Self> ConstRange;
+    typedef DefaultImageRange<Self> Range;
+
+    /// output iterator
+    typedef SetValueIterator<Self> OutputIterator;
+
+    /// The type of the words of the masks of active points.
+    typedef std::uint64_t Word;
+
+    /// Number of points of a leaf.
+    BOOST_STATIC_CONSTANT( Size, leafVolume = Size( 1 ) << ( dimension * TLogLeafSize ) );
+    /// Number of leaves of an internal node.
+    BOOST_STATIC_CONSTANT( Size, nodeVolume = Size( 1 ) << ( dimension * TLogNodeSize ) );
+    /// Number of words of the mask of a leaf.
+    BOOST_STATIC_CONSTANT( Size, maskWords = ( leafVolume + 63 ) / 64 );
+
+  private:
+    /// A dense brick of values with the mask of its active points.
+    struct Leaf
+    {
+      /// The lowest point of the leaf.
+      Point origin;
+      /// The values of the points, the first axis being the fastest.
+      std::array<Value, leafVolume> values;
+      /// The mask of active points.
+      std::array<Word, maskWords> mask;
+    };
+
+    /// An internal node, referencing the leaves of a tile.
+    struct Node
+    {
+      /// For each leaf of the tile, its index in myLeaves plus one, or 0.
+      std::vector<std::uint32_t> children;
+      /// The number of non-null children.
+      Size nbChildren;
+    };
+
+  public:
+    /**
+     * Forward iterator over the active points, leaf after leaf. It is
+     * not invalidated by insertions or erasures, but by prune() and
+     * clear().
+     */
+    class ActiveIterator
+      : public boost::iterator_facade< ActiveIterator, Point const,
+                                       boost::forward_traversal_tag, Point >
+    {
+    public:
+      /// Default constructor (singular iterator).
+      ActiveIterator();
+
+      /**
+       * Constructor.
+       * @param leaves the leaves of the image.
+       * @param aLeaf the index of a leaf.
+       * @param aBit the index of the first point to look at in the leaf.
+       */
+      ActiveIterator( const std::vector<Leaf> & leaves, Size aLeaf, Size aBit );
+
+    private:
+      friend class boost::iterator_core_access;
+      friend class ImageContainerBySparseTree;
+      void increment();
+      bool equal( const ActiveIterator & other ) const;
+      Point dereference() const;
+      /// Moves to the first active point from the current position.
+      void seek();
+
+      /// The leaves of the image.
+      const std::vector<Leaf> * myLeaves;
+      /// The index of the current leaf.
+      Size myLeaf;
+      /// The index of the current point in the leaf.
+      Size myBit;
+    };
+
+    /// Iterator over the points of the set (the active points).
+    typedef ActiveIterator Iterator;
+    /// Const iterator over the points of the set (the active points).
+    typedef ActiveIterator ConstIterator;
+
+    /////////////////// standard services //////////////////
+  public:
+
+    /**
+     * Constructor. The image has no active point.
+     *
+     * @param aDomain the image domain.
+     * @param aBackground the value of inactive points.
+     * @param aForeground the value given to points inserted with the
+     * set services.
+     */
+    ImageContainerBySparseTree( const Domain & aDomain,
+                                const Value & aBackground = Value(),
+                                const Value & aForeground = Value( 1 ) );
+
+    /////////////////// CImage interface //////////////////
+  public:
+
+    /**
+     * Get the value of an image at a given position. When Value is
+     * bool, this is also the point predicate of the set.
+     *
+     * @pre the point must be in the domain
+     * @param aPoint the point.
+     * @return the value at aPoint, the background value if inactive.
+     */
+    Value operator()( const Point & aPoint ) const;
+
+    /**
+     * Set a value on an Image at a given position. The point becomes
+     * active, or inactive if aValue is the background value.
+     *
+     * @pre the point must be in the domain
+     * @param aPoint the point.
+     * @param aValue the value.
+     */
+    void setValue( const Point & aPoint, const Value & aValue );
+
+    /// @return the domain associated to the image.
+    const Domain & domain() const;
+
+    /// @return the const range providing constant iterators to
+    /// iterate over the values of the image, in the domain order.
+    ConstRange constRange() const;
+
+    /// @return the range providing constant iterators and output
+    /// iterators on the values of the image.
+    Range range();
+
+    /// @return an output iterator writing values in the domain order.
+    OutputIterator outputIterator();
+
+    /////////////////// CDigitalSet interface //////////////////
+  public:
+
+    /// @return a copy on write pointer on the embedding domain.
+    CowPtr<Domain> domainPointer() const;
+
+    /// @return the number of active points.
+    Size size() const;
+
+    /// @return 'true' iff there is no active point.
+    bool empty() const;
+
+    /**
+     * Activates a point, with the foreground value if it was inactive.
+     * @param p any point of the domain.
+     */
+    void insert( const Point & p );
+
+    /**
+     * Activates the points of a range.
+     * @param first the start point in the collection of Point.
+     * @param last the last point in the collection of Point.
+     */
+    template <typename PointInputIterator>
+    void insert( PointInputIterator first, PointInputIterator last );
+
+    /**
+     * Activates a point, with the foreground value.
+     * @param p any point of the domain.
+     * @pre p should not be active.
+     */
+    void insertNew( const Point & p );
+
+    /**
+     * Activates the points of a range.
+     * @param first the start point in the collection of Point.
+     * @param last the last point in the collection of Point.
+     * @pre the points should not be active.
+     */
+    template <typename PointInputIterator>
+    void insertNew( PointInputIterator first, PointInputIterator last );
+
+    /**
+     * Deactivates a point.
+     * @param p any point of the domain.
+     * @return the number of deactivated points (0 or 1).
+     */
+    Size erase( const Point & p );
+
+    /**
+     * Deactivates the point pointed by an iterator.
+     * @param it an iterator on this set, different from end().
+     */
+    void erase( Iterator it );
+
+    /**
+     * Deactivates the points of a range of this set.
+     * @param first the start point in this set.
+     * @param last the last point in this set.
+     */
+    void erase( Iterator first, Iterator last );
+
+    /**
+     * Deactivates all points and releases all leaves and nodes.
+     * @post this set is empty.
+     */
+    void clear();
+
+    /**
+     * @param p any point.
+     * @return an iterator pointing on [p] if active, otherwise end().
+     */
+    ConstIterator find( const Point & p ) const;
+
+    /**
+     * @param p any point.
+     * @return an iterator pointing on [p] if active, otherwise end().
+     */
+    Iterator find( const Point & p );
+
+    /// @return an iterator on the first active point.
+    ConstIterator begin() const;
+
+    /// @return an iterator after the last active point.
+    ConstIterator end() const;
+
+    /// @return an iterator on the first active point.
+    Iterator begin();
+
+    /// @return an iterator after the last active point.
+    Iterator end();
+
+    /**
+     * Set union to left.
+     * @param aSet any other set, whose points lie in the domain.
+     * @return a reference on 'this'.
+     */
+    Self & operator+=( const Self & aSet );
+
+    /**
+     * Computes the complement in the domain of this set.
+     * @param ito an output iterator
+     * @tparam TOutputIterator a model of output iterator
+     */
+    template< typename TOutputIterator >
+    void computeComplement( TOutputIterator & ito ) const;
+
+    /**
+     * Builds the complement in the domain of the set [other_set] in
+     * this.
+     * @param other_set defines the set whose complement is assigned to 'this'.
+     */
+    void assignFromComplement( const Self & other_set );
+
+    /**
+     * Computes the bounding box of the active points.
+     * @param lower the lowest point of the bounding box.
+     * @param upper the highest point of the bounding box.
+     */
+    void computeBoundingBox( Point & lower, Point & upper ) const;
+
+    /////////////////// Sparse services //////////////////
+  public:
+
+    /// @return the number of points of a leaf along each axis.
+    static Size leafSize();
+
+    /// @return the value of inactive points.
+    const Value & background() const;
+
+    /// @return the value of points inserted with the set services.
+    const Value & foreground() const;
+
+    /// @return the number of allocated leaves.
+    Size nbLeaves() const;
+
+    /// @return the number of allocated internal nodes.
+    Size nbNodes() const;
+
+    /**
+     * Releases the leaves without active point, and the internal nodes
+     * without leaves. Invalidates iterators.
+     */
+    void prune();
+
+    /////////////////// Interface //////////////////
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    /**
+     * @return the style name used for drawing this object.
+     */
+    std::string className() const;
+
+    /////////////////// Internals //////////////////
+  private:
+
+    /// @param q a point relative to the lower bound of the domain.
+    /// @return the key of its tile in the root.
+    Size tileKey( const Point & q ) const;
+
+    /// @param q a point relative to the lower bound of the domain.
+    /// @return the index of its leaf in its internal node.
+    static Size childIndex( const Point & q );
+
+    /// @param q a point relative to the lower bound of the domain.
+    /// @return the index of the point in its leaf.
+    static Size pointIndex( const Point & q );
+
+    /// @param p any point of the domain.
+    /// @return the index of the leaf of p in myLeaves plus one, or 0.
+    Size findLeaf( const Point & p ) const;
+
+    /// @param p any point of the domain.
+    /// @return the index of the leaf of p in myLeaves, created if needed.
+    Size touchLeaf( const Point & p );
+
+    /// @param w a non-null word.
+    /// @return the index of its lowest set bit.
+    static unsigned int lowestBit( Word w );
+
+    /////////////////// Data members //////////////////
+  private:
+    /// Image domain
+    CowPtr<Domain> myDomain;
+    /// For each axis, the stride of tiles in the keys of the root.
+    std::array<Size, dimension> myTileStrides;
+    /// The value of inactive points.
+    Value myBackground;
+    /// The value of points inserted with the set services.
+    Value myForeground;
+    /// The root, from tile keys to internal nodes.
+    std::unordered_map<Size, Node> myRoot;
+    /// The leaves.
+    std::vector<Leaf> myLeaves;
+    /// The number of active points.
+    Size mySize;
+
+  }; // end of class ImageContainerBySparseTree
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'ImageContainerBySparseTree'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'ImageContainerBySparseTree' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TDomain, typename TValue,
+            unsigned int TLogLeafSize, unsigned int TLogNodeSize>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const ImageContainerBySparseTree<TDomain, TValue, TLogLeafSize, TLogNodeSize> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/images/ImageContainerBySparseTree.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined ImageContainerBySparseTree_h
+
+#undef ImageContainerBySparseTree_RECURSES
+#endif // else defined(ImageContainerBySparseTree_RECURSES)
@@ -71,6 +71,11 @@ namespace DGtal
    * @note It is important to take into account that read and write policies are passed as aliases in the TiledImage constructor,
    * so for example, if two TiledImage instances are successively created with the same read policy instance,
    * the state of the cache for a given time is therefore the same for the two TiledImage instances !
+   *
+   * @note Reading and writing values (operator() and setValue) are thread-safe, so that several threads
+   * may share one TiledImage (not copies of it), see ImageCache. Tile iterators (TiledIterator, range and
+   * constRange) keep pointers on tiles, and should not be used while other threads may evict tiles.
+   * Adjacent tiles of a tile that is not in the cache may be prefetched asynchronously, see setPrefetchNeighbors.
    */
   template <typename TImageContainer, typename TImageFactory, typename TImageCacheReadPolicy, typename TImageCacheWritePolicy>
   class TiledImage
@@ -118,7 +123,8 @@ namespace DGtal
                Alias<ImageCacheReadPolicy> aReadPolicy,
                Alias<ImageCacheWritePolicy> aWritePolicy,
                typename Domain::Integer N):
-      myN(N), myImageFactory(&anImageFactory), myReadPolicy(&aReadPolicy), myWritePolicy(&aWritePolicy)
+      myN(N), myImageFactory(&anImageFactory), myReadPolicy(&aReadPolicy), myWritePolicy(&aWritePolicy),
+      myPrefetchNeighbors(false)
     {
       myImageCache = new MyImageCache(myImageFactory, myReadPolicy, myWritePolicy);
 
@@ -148,6 +154,7 @@ namespace DGtal
     TiledImage( const TiledImage &other )
     {
       myN =  other.myN;
+      myPrefetchNeighbors = other.myPrefetchNeighbors;
       myImageFactory = other.myImageFactory;
       myReadPolicy = other.myReadPolicy;
       myWritePolicy = other.myWritePolicy;
@@ -171,6 +178,7 @@ namespace DGtal
         if ( this != &other )
         {
           myN =  other.myN;
+          myPrefetchNeighbors = other.myPrefetchNeighbors;
           myImageFactory = other.myImageFactory;
           myReadPolicy = other.myReadPolicy;
           myWritePolicy = other.myWritePolicy;
@@ -722,9 +730,10 @@ namespace DGtal
 #endif 
           d = findSubDomain(aPoint);
 
-          myImageCache->update(d);
+          myImageCache->updateAndRead(d, aPoint, aValue);
 
-          myImageCache->read(aPoint, aValue);
+          if (myPrefetchNeighbors)
+            prefetchNeighbors(aPoint);
 
           return aValue;
         }
@@ -748,15 +757,17 @@ namespace DGtal
       else
         {
           myImageCache->incCacheMissWrite();
-          myImageCache->update(findSubDomain(aPoint));
-          myImageCache->write(aPoint, aValue);
+          myImageCache->updateAndWrite(findSubDomain(aPoint), aPoint, aValue);
+
+          if (myPrefetchNeighbors)
+            prefetchNeighbors(aPoint);
         }
     }
 
     /**
      * Get the cacheMissRead value.
      */
-    unsigned int getCacheMissRead()
+    unsigned int getCacheMissRead() const
     {
       return myImageCache->getCacheMissRead();
     }
@@ -764,11 +775,57 @@ namespace DGtal
     /**
      * Get the cacheMissWrite value.
      */
-    unsigned int getCacheMissWrite()
+    unsigned int getCacheMissWrite() const
     {
       return myImageCache->getCacheMissWrite();
     }
 
+    /**
+     * Get the number of values read in tiles of the cache.
+     */
+    unsigned long getCacheHits() const
+    {
+      return myImageCache->getCacheHits();
+    }
+
+    /**
+     * Get the number of tiles detached from the cache.
+     */
+    unsigned long getCacheEvictions() const
+    {
+      return myImageCache->getCacheEvictions();
+    }
+
+    /**
+     * Get the number of tiles loaded in advance.
+     */
+    unsigned long getCachePrefetches() const
+    {
+      return myImageCache->getCachePrefetches();
+    }
+
+    /**
+     * When set, each cache miss also asks the cache to load
+     * asynchronously the (2*dimension) tiles adjacent to the missing
+     * one, so that scans crossing tile borders find them in the
+     * cache. The read policy should keep enough tiles (e.g.
+     * ImageCacheReadPolicyLRU with a size of at least 2*dimension+1).
+     *
+     * @param aFlag 'true' to prefetch adjacent tiles.
+     */
+    void setPrefetchNeighbors(bool aFlag)
+    {
+      myPrefetchNeighbors = aFlag;
+    }
+
+    /**
+     * Wait until all the tiles asked for prefetching are loaded.
+     */
+    void waitPrefetches()
+    {
+      myImageCache->waitPrefetches();
+    }
+
     /**
      * Clear the cache and reset the cache misses
      */
@@ -801,7 +858,30 @@ namespace DGtal
     /// TImageCacheWritePolicy pointer
     TImageCacheWritePolicy *myWritePolicy;
 
+    /// When 'true', the tiles adjacent to a missing tile are prefetched
+    bool myPrefetchNeighbors;
+
     // ------------------------- Internals ------------------------------------
+  private:
+
+    /**
+     * Ask the cache to prefetch the tiles adjacent to the tile of aPoint.
+     *
+     * @param aPoint the point.
+     */
+    void prefetchNeighbors(const Point & aPoint) const
+    {
+      const Domain blocks = domainBlockCoords();
+      const Point coords = findBlockCoordsFromPoint(aPoint);
+      for(typename DGtal::Dimension i=0; i<Domain::dimension; i++)
+        for(int step = -1; step <= 1; step += 2)
+          {
+            Point neighbor = coords;
+            neighbor[i] += step;
+            if (blocks.isInside(neighbor))
+              myImageCache->prefetch(findSubDomainFromBlockCoords(neighbor));
+          }
+    }
 
   }; // end of class TiledImage
 
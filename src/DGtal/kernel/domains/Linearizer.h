@@ -60,6 +60,23 @@ namespace DGtal
    */
   struct ColMajorStorage {};
 
+  /**
+   * @brief Tag (empty structure) specifying a bricked storage order.
+   *
+   * The domain is cut into bricks of \f$ 2^{TLogBrickSize} \f$ points
+   * along each axis. Bricks are stored one after the other in
+   * col-major order, and the points of each brick are stored
+   * contiguously, in col-major order too. Neighbors of a point are
+   * then close in memory along every axis.
+   *
+   * @tparam TLogBrickSize the base 2 logarithm of the brick size (3
+   * gives bricks of 8x8x8 points in 3D).
+   *
+   * @see Linearizer, ImageContainerByBricks
+   */
+  template < unsigned int TLogBrickSize = 3 >
+  struct BrickedStorage {};
+
   /////////////////////////////////////////////////////////////////////////////
   /**
    * @brief Aim: Linearization and de-linearization interface for domains.
@@ -174,6 +191,113 @@ namespace DGtal
 
   }; // end of class Linearizer
 
+  /**
+   * @brief Aim: Linearization and de-linearization interface for
+   * HyperRectDomain with a bricked storage order.
+   *
+   * Same interface as the other linearizers for HyperRectDomain, but
+   * points are grouped by bricks (see BrickedStorage). Since the
+   * extent of the domain is rounded up to a multiple of the brick
+   * size, indices range from 0 to getSize( anExtent ) - 1, which may
+   * be greater than the number of points of the domain.
+   *
+   * @code
+   * typedef Linearizer< Z3i::Domain, BrickedStorage<3> > BrickLinearizer;
+   * const Z3i::Domain domain( Z3i::Point( 0, 0, 0 ), Z3i::Point( 9, 9, 9 ) );
+   * BrickLinearizer::getIndex( Z3i::Point( 7, 0, 0 ), domain ); // returns 7.
+   * BrickLinearizer::getIndex( Z3i::Point( 0, 1, 0 ), domain ); // returns 8.
+   * BrickLinearizer::getIndex( Z3i::Point( 8, 0, 0 ), domain ); // returns 512.
+   * @endcode
+   *
+   * @tparam  TSpace        Type of the space of the HyperRectDomain.
+   * @tparam  TLogBrickSize The base 2 logarithm of the brick size.
+   */
+  template <
+      typename TSpace,
+      unsigned int TLogBrickSize
+    >
+  struct Linearizer< HyperRectDomain<TSpace>, BrickedStorage<TLogBrickSize> >
+    {
+      // Usefull typedefs
+      typedef HyperRectDomain<TSpace> Domain; ///< The domain type.
+      typedef typename TSpace::Point Point;   ///< The point type.
+      typedef Point Extent;                   ///< The domain's extent type.
+      typedef typename TSpace::Size  Size;    ///< The space's size type.
+
+      /// The number of points of a brick along each axis.
+      static const Size brickSize = Size( 1 ) << TLogBrickSize;
+
+      /** Number of indices (i.e. of points of the bricks covering the
+       * domain), given the domain extent.
+       *
+       * @param[in] anExtent  The extent of the domain.
+       * @return the number of indices.
+       */
+      static inline
+      Size getSize( Extent const& anExtent );
+
+      /** Linearized index of a point, given the domain lower-bound and extent.
+       *
+       * @param[in] aPoint      The point to be linearized.
+       * @param[in] aLowerBound The lower-bound of the domain.
+       * @param[in] anExtent    The extent of the domain.
+       * @return the linearized index of the point.
+       */
+      static inline
+      Size getIndex( Point aPoint, Point const& aLowerBound, Extent const& anExtent );
+
+      /** Linearized index of a point, given the domain extent.
+       *
+       * The lower-bound of the domain is defined to the origin.
+       *
+       * @param[in] aPoint    The Point to be linearized.
+       * @param[in] anExtent  The extent of the domain.
+       * @return the linearized index of the point.
+       */
+      static inline
+      Size getIndex( Point aPoint, Extent const& anExtent );
+
+      /** Linearized index of a point, given a domain.
+       *
+       * @param[in] aPoint    The Point to be linearized.
+       * @param[in] aDomain   The domain.
+       * @return the linearized index of the point.
+       */
+      static inline
+      Size getIndex( Point aPoint, Domain const& aDomain );
+
+      /** De-linearization of an index, given the domain lower-bound and extent.
+       *
+       * @param[in] anIndex     The linearized index.
+       * @param[in] aLowerBound The lower-bound of the domain.
+       * @param[in] anExtent    The domain extent.
+       * @return  the point whose linearized index is anIndex.
+       */
+      static inline
+      Point getPoint( Size anIndex, Point const& aLowerBound, Extent const& anExtent );
+
+      /** De-linearization of an index, given the domain extent.
+       *
+       * The lower-bound of the domain is set to the origin.
+       *
+       * @param[in] anIndex   The linearized index.
+       * @param[in] anExtent  The domain extent.
+       * @return  the point whose linearized index is anIndex.
+       */
+      static inline
+      Point getPoint( Size anIndex, Extent const& anExtent );
+
+      /** De-linearization of an index, given a domain.
+       *
+       * @param[in] anIndex   The linearized index.
+       * @param[in] aDomain   The domain.
+       * @return  the point whose linearized index is anIndex.
+       */
+      static inline
+      Point getPoint( Size anIndex, Domain const& aDomain );
+
+  }; // end of class Linearizer
+
 } // namespace DGtal
 
 
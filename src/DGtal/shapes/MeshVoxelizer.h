@@ -120,6 +120,12 @@ namespace DGtal
      * If one voxel is outside the digtial set (@a outputSet) domain, the voxel
      * is skipped.
      *
+     * With OpenMP, faces are voxelized in parallel: each thread
+     * collects its voxels in its own buffer, buffers are sorted and
+     * merged at the end, then inserted in @a outputSet. Hence no
+     * per-face set is allocated and threads never synchronize while
+     * voxelizing.
+     *
      * @param [out] outputSet the set that collects the voxels.
      * @param [in] aMesh the mesh to voxelize (vertex coordinates will
      * be casted to @e PointR3 points.
@@ -209,6 +215,46 @@ namespace DGtal
                           const VectorR3& n,
                           const std::pair<PointZ3, PointZ3>& bbox);
 
+    // ----------------------- Hidden services ------------------------------
+
+  private:
+
+    /**
+     * Calls @a visitor on each voxel of the digitization of ABC,
+     * whether it lies in the domain or not. A voxel may be visited
+     * several times.
+     * @param A Point A
+     * @param B Point B
+     * @param C Point C
+     * @param n normal of ABC
+     * @param bbox bounding box of ABC
+     * @param visitor a functor called on each visited voxel (PointZ3).
+     * @tparam VoxelVisitor the type of the functor.
+     */
+    template<typename VoxelVisitor>
+    void visitTriangleVoxels(const PointR3& A,
+                             const PointR3& B,
+                             const PointR3& C,
+                             const VectorR3& n,
+                             const std::pair<PointZ3, PointZ3>& bbox,
+                             VoxelVisitor visitor) const;
+
+    /**
+     * Calls @a visitor on each voxel of the digitization of the
+     * triangle (a,b,c) scaled by @a scaleFactor.
+     * @param [in] a the first point of the triangle
+     * @param [in] b the second point of the triangle
+     * @param [in] c the third point of the triangle
+     * @param [in] scaleFactor the scale factor to apply to the triangle
+     * @param visitor a functor called on each visited voxel (PointZ3).
+     * @tparam MeshPoint the type of point of the triangle.
+     * @tparam VoxelVisitor the type of the functor.
+     */
+    template<typename MeshPoint, typename VoxelVisitor>
+    void visitVoxels(const MeshPoint &a, const MeshPoint &b, const MeshPoint &c,
+                     const double scaleFactor,
+                     VoxelVisitor visitor) const;
+
     // ----------------------- Members ------------------------------
 
   private:
@@ -45,6 +45,7 @@
 #include <string>
 #include "DGtal/base/Common.h"
 #include "DGtal/base/IntegerSequenceIterator.h"
+#include "DGtal/base/CompressedIndexRanges.h"
 #include "DGtal/helpers/StdDefs.h"
 
 namespace DGtal
@@ -84,6 +85,14 @@ namespace DGtal
      See also SurfaceMeshReader and SurfaceMeshWriter for input/output
      operations for SurfaceMesh.
 
+     The topology (incident vertices of faces, incident faces of
+     vertices, neighbors, faces of edges) is stored as compressed
+     ranges, i.e. one offset array and one index array per relation
+     (see CompressedIndexRanges). Accessors thus return lightweight
+     views (IndexRange) on these arrays, which are invalidated when the
+     mesh is modified (e.g. by \ref flip), and convert to Vertices or
+     Faces when a copy is needed.
+
      @tparam TRealPoint an arbitrary model of 3D RealPoint.
      @tparam TRealVector an arbitrary model of 3D RealVector.
   */
@@ -116,6 +125,10 @@ namespace DGtal
     typedef std::vector< Face >                     Faces;
     typedef std::vector< WeightedFace >             WeightedFaces;
     typedef std::pair< Vertex, Vertex >             VertexPair;
+    /// The type storing a range of indices per element (vertex, edge or face).
+    typedef CompressedIndexRanges< Index >          IndexRanges;
+    /// The type of non mutable view on the range of indices of an element.
+    typedef typename IndexRanges::Range             IndexRange;
 
     // Required by CUndirectedSimpleLocalGraph
     typedef std::set<Vertex>                   VertexSet;
@@ -306,29 +319,31 @@ namespace DGtal
     /// @param j any vertex of the mesh
     /// @return the edge index of edge (i,j) or `nbEdges()` if this
     /// edge does not exist.
-    /// @note O(log E) time complexity.
+    /// @note O(log d) time complexity, where d is the number of edges
+    /// whose smallest vertex is min(i,j) (plus O(log F') if F' edges
+    /// have been flipped).
     Edge makeEdge( Vertex i, Vertex j ) const;
 
     /// @param f any face
-    /// @return a const reference to the range giving for face \a f 
+    /// @return a view on the range giving for face \a f 
     /// its incident vertices.
-    const Vertices&  incidentVertices( Face f ) const
+    IndexRange incidentVertices( Face f ) const
     { return myIncidentVertices[ f ]; }
 
     /// @param v any vertex
-    /// @return a const reference to the range giving for vertex \a v
+    /// @return a view on the range giving for vertex \a v
     /// its incident faces.
-    const Faces& incidentFaces( Vertex v ) const
+    IndexRange incidentFaces( Vertex v ) const
     { return myIncidentFaces[ v ]; }
     
     /// @param f any face
-    /// @return a const reference to the range of neighbor faces for face \a f.
-    const Faces& neighborFaces( Face f ) const
+    /// @return a view on the range of neighbor faces for face \a f.
+    IndexRange neighborFaces( Face f ) const
     { return myNeighborFaces[ f ]; }
 
     /// @param v any vertex
-    /// @return a const reference to the range of neighbor vertices for vertex \a v.
-    const Vertices& neighborVertices( Vertex v ) const
+    /// @return a view on the range of neighbor vertices for vertex \a v.
+    IndexRange neighborVertices( Vertex v ) const
     { return myNeighborVertices[ v ]; }
 
     /// @param e any edge
@@ -339,49 +354,49 @@ namespace DGtal
     { return myEdgeVertices[ e ]; }
     
     /// @param e any edge
-    /// @return a const reference to the range giving for edge \a e
+    /// @return a view on the range giving for edge \a e
     /// its incident faces (one, two, or more if non manifold)
-    const Faces& edgeFaces( Edge e ) const
+    IndexRange edgeFaces( Edge e ) const
     { return myEdgeFaces[ e ]; }
 
     /// @param e any edge
-    /// @return a const reference to the range giving for edge \a e
+    /// @return a view on the range giving for edge \a e
     /// its incident faces to its right (zero if open, one, or more if
     /// non manifold).
     ///
     /// @note an edge is stored as a vertex pair (i,j), i < j. So a
     /// face to its right, being defined ccw, means that the face is
     /// some `(..., j, i, ... )`.
-    const Faces& edgeRightFaces( Edge e ) const 
+    IndexRange edgeRightFaces( Edge e ) const 
     { return myEdgeRightFaces[ e ]; }
 
     /// @param e any edge
-    /// @return a const reference to the range giving for edge \a e
+    /// @return a view on the range giving for edge \a e
     /// its incident faces to its left (zero if open, one, or more if
     /// non manifold).
     ///
     /// @note an edge is stored as a vertex pair (i,j), i < j. So a
     /// face to its left, being defined ccw, means that the face is
     /// some `(..., i, j, ... )`.
-    const Faces& edgeLeftFaces( Edge e ) const 
+    IndexRange edgeLeftFaces( Edge e ) const 
     { return myEdgeLeftFaces[ e ]; }
 
-    /// @return a const reference to the vector giving for each face
+    /// @return a const reference to the ranges giving for each face
     /// its incident vertices.
-    const std::vector< Vertices >& allIncidentVertices() const
+    const IndexRanges& allIncidentVertices() const
     { return myIncidentVertices; }
 
-    /// @return a const reference to the vector giving for each vertex
+    /// @return a const reference to the ranges giving for each vertex
     /// its incident faces.
-    const std::vector< Faces >& allIncidentFaces() const
+    const IndexRanges& allIncidentFaces() const
     { return myIncidentFaces; }
     
-    /// @return a const reference to the vector of neighbor faces for each face.
-    const std::vector< Faces >& allNeighborFaces() const
+    /// @return a const reference to the ranges of neighbor faces for each face.
+    const IndexRanges& allNeighborFaces() const
     { return myNeighborFaces; }
 
-    /// @return a const reference to the vector of neighbor vertices for each vertex.
-    const std::vector< Vertices >& allNeighborVertices() const
+    /// @return a const reference to the ranges of neighbor vertices for each vertex.
+    const IndexRanges& allNeighborVertices() const
     { return myNeighborVertices; }
 
     /// @return a vector giving for each edge its two vertices (as a
@@ -391,29 +406,29 @@ namespace DGtal
     const std::vector< VertexPair >& allEdgeVertices() const
     { return myEdgeVertices; }
     
-    /// @return a const reference to the vector giving for each edge
+    /// @return a const reference to the ranges giving for each edge
     /// its incident faces (one, two, or more if non manifold)
-    const std::vector< Faces >& allEdgeFaces() const
+    const IndexRanges& allEdgeFaces() const
     { return myEdgeFaces; }
 
-    /// @return a const reference to the vector giving for each edge
+    /// @return a const reference to the ranges giving for each edge
     /// its incident faces to its right (zero if open, one, or more if
     /// non manifold).
     ///
     /// @note an edge is stored as a vertex pair (i,j), i < j. So a
     /// face to its right, being defined ccw, means that the face is
     /// some `(..., j, i, ... )`.
-    const std::vector< Faces >& allEdgeRightFaces() const 
+    const IndexRanges& allEdgeRightFaces() const 
     { return myEdgeRightFaces; }
 
-    /// @return a const reference to the vector giving for each edge
+    /// @return a const reference to the ranges giving for each edge
     /// its incident faces to its left (zero if open, one, or more if
     /// non manifold).
     ///
     /// @note an edge is stored as a vertex pair (i,j), i < j. So a
     /// face to its left, being defined ccw, means that the face is
     /// some `(..., i, j, ... )`.
-    const std::vector< Faces >& allEdgeLeftFaces() const 
+    const IndexRanges& allEdgeLeftFaces() const 
     { return myEdgeLeftFaces; }
     
     /// @}
@@ -939,9 +954,18 @@ namespace DGtal
     /// @name Look-up table computation services
     /// @{
     
-    /// Computes neighboring information.
+    /// Computes neighboring information. The ranges of incident
+    /// faces and vertices edited by \ref flip are compacted back into
+    /// their arrays.
+    /// @note Vertices and faces are processed in parallel when DGtal
+    /// is built with OpenMP.
     void computeNeighbors();
-    /// Computes edge information.
+    /// Computes edge information. Edges are numbered in the
+    /// lexicographic order of their vertex pairs. They are built by
+    /// bucketing the half-edges of faces by smallest vertex and sorting
+    /// each bucket (in parallel when DGtal is built with OpenMP), so
+    /// that the vertex pair to edge lookup is a compressed (offset +
+    /// index array) table instead of a map.
     void computeEdges();
 
     /// @}
@@ -964,9 +988,9 @@ namespace DGtal
     // ------------------------- Protected Datas ------------------------------
   protected:
     /// For each face, its range of incident vertices
-    std::vector< Vertices >     myIncidentVertices;
+    IndexRanges                 myIncidentVertices;
     /// For each vertex, its range of incident faces
-    std::vector< Faces >        myIncidentFaces;
+    IndexRanges                 myIncidentFaces;
     /// For each vertex, its position
     std::vector< RealPoint >    myPositions;
     /// For each vertex, its normal vector
@@ -974,27 +998,35 @@ namespace DGtal
     /// For each face, its normal vector
     std::vector< RealVector >   myFaceNormals;
     /// For each face, its range of neighbor faces (no particular order)
-    std::vector< Faces >        myNeighborFaces;
+    IndexRanges                 myNeighborFaces;
     /// For each vertex, its range of neighbor vertices (no particular order)
-    std::vector< Vertices >     myNeighborVertices;
+    IndexRanges                 myNeighborVertices;
     /// For each edge, its two vertices
     std::vector< VertexPair >   myEdgeVertices;
-    /// For each vertex pair, its edge index.
-    std::map< VertexPair,Edge > myVertexPairEdge;
+    /// For each vertex i, the offset of its range in
+    /// myVertexEdgeTargets (size is nbVertices()+1). Edges (i,j) with
+    /// i < j, as built by computeEdges, are numbered contiguously, so
+    /// the edge at position p in this compressed table is edge p.
+    std::vector< Index >        myVertexEdgeOffsets;
+    /// For each edge (i,j), i < j, as built by computeEdges, the vertex
+    /// j. Ranges are sorted, so that makeEdge is a binary search.
+    std::vector< Vertex >       myVertexEdgeTargets;
+    /// For each vertex pair created by \ref flip, its edge index.
+    std::map< VertexPair,Edge > myFlippedVertexPairEdge;
     /// For each edge, its faces (one, two, or more if non manifold)
-    std::vector< Faces >        myEdgeFaces;
+    IndexRanges                 myEdgeFaces;
     /// For each edge, its faces to its right  (zero if open, one, or more if
     /// non manifold).
     /// @note an edge is stored as a vertex pair (i,j), i < j. So a
     /// face to its right, being defined ccw, means that the face is
     /// some `(..., j, i, ... )`.
-    std::vector< Faces >        myEdgeRightFaces;
+    IndexRanges                 myEdgeRightFaces;
     /// For each edge, its faces to its left  (zero if open, one, or more if
     /// non manifold).
     /// @note an edge is stored as a vertex pair (i,j), i < j. So a
     /// face to its left, being defined ccw, means that the face is
     /// some `(..., i, j, ... )`.
-    std::vector< Faces >        myEdgeLeftFaces;
+    IndexRanges                 myEdgeLeftFaces;
 
     // ------------------------- Private Datas --------------------------------
   private:
@@ -1003,52 +1035,65 @@ namespace DGtal
     // ------------------------- Internals ------------------------------------
   protected:
 
-    /// Removes the index \a i from the vector \a v.
-    /// @param[inout] v a vector of indices
+    /// Computes the range of indices of each element 0, ..., \a n-1
+    /// (in parallel when DGtal is built with OpenMP) and stores
+    /// them in \a ranges.
+    /// @tparam RangeFunctor the type of a function `void( Index, std::vector< Index >& )`.
+    /// @param[out] ranges the computed ranges of indices.
+    /// @param[in] n the number of elements.
+    /// @param[in] compute the function that appends to its second
+    /// argument (given empty) the indices of the element given as
+    /// first argument.
+    template <typename RangeFunctor>
+    static void computeRanges( IndexRanges& ranges, Size n, RangeFunctor compute );
+
+    /// Removes the index \a i from the range \a r of \a ranges.
+    /// @param[inout] ranges some ranges of indices
+    /// @param[in] r a range number
     /// @param[in] i an index
-    void removeIndex( std::vector< Index >& v, Index i )
+    void removeIndex( IndexRanges& ranges, Index r, Index i )
     {
-      const std::size_t n = v.size();
-      for ( std::size_t j = 0; j < n; j++ )
-	if ( v[ j ] == i )
-	  {
-	    std::swap( v[ j ], v.back() );
-	    v.resize( n - 1 );
-	    return;
-	  }
+      if ( ranges.remove( r, i ) ) return;
       trace.error() << "[SurfaceMesh::removeIndex] Index " << i
 		    << " is not in vector:";
-      for ( auto e : v ) std::cerr << " " << e;
+      for ( auto e : ranges[ r ] ) std::cerr << " " << e;
       std::cerr << std::endl;
     }
 
-    /// Replaces the index \a i with the index \a ri in the vector \a v.
-    /// @param[inout] v a vector of indices
+    /// Replaces the index \a i with the index \a ri in the range \a r of \a ranges.
+    /// @param[inout] ranges some ranges of indices
+    /// @param[in] r a range number
     /// @param[in] i an index
     /// @param[in] ri an index    
-    void replaceIndex( std::vector< Index >& v, Index i, Index ri )
+    void replaceIndex( IndexRanges& ranges, Index r, Index i, Index ri )
     {
-      const std::size_t n = v.size();
-      for ( std::size_t j = 0; j < n; j++ )
-	if ( v[ j ] == i )
-	  {
-	    v[ j ] = ri;
-	    return;
-	  }
+      if ( ranges.replace( r, i, ri ) ) return;
       trace.error() << "[SurfaceMesh::replaceIndex] Index " << i
 		    << " (subs=" << ri << ") is not in vector:";
-      for ( auto e : v ) std::cerr << " " << e;
+      for ( auto e : ranges[ r ] ) std::cerr << " " << e;
       std::cerr << std::endl;
     }
 
-    /// Adds the index \a i to the vector \a v.
-    /// @param[inout] v a vector of indices
+    /// Adds the index \a i to the range \a r of \a ranges.
+    /// @param[inout] ranges some ranges of indices
+    /// @param[in] r a range number
     /// @param[in] i an index
-    void addIndex( std::vector< Index >& v, Index i )
+    void addIndex( IndexRanges& ranges, Index r, Index i )
     {
-      v.push_back( i );
+      ranges.add( r, i );
     }
-    
+
+    /// Changes the vertices of the edge \a e after a flip, and updates
+    /// the vertex pair to edge lookup accordingly.
+    /// @param[in] e an edge
+    /// @param[in] vp its new vertex pair (first < second)
+    void setFlippedEdgeVertices( Edge e, VertexPair vp )
+    {
+      myFlippedVertexPairEdge.erase( myEdgeVertices[ e ] );
+      myEdgeVertices[ e ] = vp;
+      myFlippedVertexPairEdge[ vp ] = e;
+    }
+
 
     /// @return a random number between 0.0 and 1.0
     static Scalar rand01()
@@ -0,0 +1,340 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file SurfaceMeshSpatialIndex.h
+ *
+ * Header file for module SurfaceMeshSpatialIndex.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(SurfaceMeshSpatialIndex_RECURSES)
+#error Recursive header files inclusion detected in SurfaceMeshSpatialIndex.h
+#else // defined(SurfaceMeshSpatialIndex_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define SurfaceMeshSpatialIndex_RECURSES
+
+#if !defined SurfaceMeshSpatialIndex_h
+/** Prevents repeated inclusion of headers. */
+#define SurfaceMeshSpatialIndex_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/ConstAlias.h"
+#include "DGtal/shapes/SurfaceMesh.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class SurfaceMeshSpatialIndex
+  /**
+     Description of template class 'SurfaceMeshSpatialIndex' <p>
+     \brief Aim: A uniform grid over the faces of a SurfaceMesh, which
+     speeds up ball queries (faces or cells within some distance of a
+     point) and nearest face queries.
+
+     Each face is referenced in every grid cell that its bounding box
+     intersects. Only non-empty cells are stored: the index is a
+     sorted array of cell codes with, for each of them, its range in an
+     array of faces (compressed offset + index layout), so that its
+     size is linear in the number of faces. It is built in parallel
+     when DGtal is built with OpenMP, and batched queries are processed
+     in parallel too.
+
+     The index references the mesh and reads its current vertex
+     positions. When vertices are moved (or faces are modified, e.g. by
+     SurfaceMesh::flip), the index must be told with
+     invalidateVertices() or invalidateFaces(): invalidated faces are
+     then checked one by one by queries, until there are enough of them
+     to justify rebuilding the grid, which is done automatically.
+
+     Contrary to SurfaceMesh::computeFacesInclusionsInBall, which grows
+     the ball from a face by breadth-first traversal of neighbor faces,
+     ball queries return all the faces close to the ball center, even
+     the ones that are not connected to the face of the center within
+     the ball.
+
+     \code
+     SurfaceMeshSpatialIndex< RealPoint, RealVector > index( smesh );
+     auto faces = index.computeFacesInclusionsInBall( 0.5, x );
+     auto fd    = index.nearestFace( x ); // (face, distance)
+     \endcode
+
+     @tparam TRealPoint an arbitrary model of 3D RealPoint.
+     @tparam TRealVector an arbitrary model of 3D RealVector.
+  */
+  template < typename TRealPoint, typename TRealVector >
+  class SurfaceMeshSpatialIndex
+  {
+    // ----------------------- Public types ------------------------------
+  public:
+    typedef TRealPoint                                        RealPoint;
+    typedef TRealVector                                       RealVector;
+    typedef SurfaceMeshSpatialIndex< RealPoint, RealVector >  Self;
+    static const Dimension dimension = RealPoint::dimension;
+    BOOST_STATIC_ASSERT( ( dimension == 3 ) );
+    typedef DGtal::SurfaceMesh< RealPoint, RealVector >       SurfaceMesh;
+    typedef typename SurfaceMesh::Scalar                      Scalar;
+    typedef typename SurfaceMesh::Size                        Size;
+    typedef typename SurfaceMesh::Index                       Index;
+    typedef typename SurfaceMesh::Vertex                      Vertex;
+    typedef typename SurfaceMesh::Edge                        Edge;
+    typedef typename SurfaceMesh::Face                        Face;
+    typedef typename SurfaceMesh::Vertices                    Vertices;
+    typedef typename SurfaceMesh::Faces                       Faces;
+    typedef typename SurfaceMesh::WeightedEdges               WeightedEdges;
+    typedef typename SurfaceMesh::WeightedFaces               WeightedFaces;
+    typedef std::vector< RealPoint >                          RealPoints;
+    /// A face with its distance to some point.
+    typedef std::pair< Face, Scalar >                         FaceDistance;
+    /// The code of a grid cell (21 bits per coordinate).
+    typedef DGtal::uint64_t                                   CellCode;
+    /// The integer coordinates of a grid cell.
+    typedef std::array< DGtal::int64_t, 3 >                   CellCoordinates;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor. Builds the index over the faces of the given mesh.
+     *
+     * @param aMesh the mesh, which is referenced in this object.
+     *
+     * @param cellSize the edge length of grid cells, or 0 to choose it
+     * automatically (about twice the average size of faces).
+     */
+    SurfaceMeshSpatialIndex( ConstAlias< SurfaceMesh > aMesh,
+                             Scalar cellSize = 0.0 );
+
+    /// Rebuilds the index with the current positions of the mesh
+    /// vertices. Invalidated faces are valid again afterwards.
+    ///
+    /// @param cellSize the edge length of grid cells, or 0 to choose it
+    /// automatically.
+    void init( Scalar cellSize = 0.0 );
+
+    /// @return the indexed mesh.
+    const SurfaceMesh& mesh() const;
+
+    /// @return the edge length of grid cells.
+    Scalar cellSize() const;
+
+    /// @return the number of non-empty cells of the grid.
+    Size nbCells() const;
+
+    // ----------------------- Invalidation services --------------------------
+  public:
+
+    /// Tells the index that the vertex \a v has moved, hence that its
+    /// incident faces must be checked individually by queries.
+    /// @param v any vertex of the mesh.
+    void invalidateVertex( Vertex v );
+
+    /// Tells the index that the given vertices have moved.
+    /// @param vertices any range of vertices of the mesh.
+    void invalidateVertices( const Vertices & vertices );
+
+    /// Tells the index that the face \a f has changed (moved vertices
+    /// or modified incident vertices).
+    /// @param f any face of the mesh.
+    void invalidateFace( Face f );
+
+    /// Tells the index that the given faces have changed.
+    /// @param faces any range of faces of the mesh.
+    void invalidateFaces( const Faces & faces );
+
+    /// @return the number of faces invalidated since the last build of the index.
+    Size nbInvalidatedFaces() const;
+
+    // ----------------------- Query services ---------------------------------
+  public:
+
+    /// @param p any point.
+    /// @param f any face of the mesh.
+    /// @return the Euclidean distance between \a p and the face \a f
+    /// (its fan triangulation from its first vertex).
+    Scalar distanceToFace( const RealPoint & p, Face f ) const;
+
+    /// @param p any point.
+    /// @param r a non-negative radius.
+    /// @return the faces at distance at most \a r from \a p, sorted by
+    /// increasing index.
+    Faces facesInBall( const RealPoint & p, Scalar r ) const;
+
+    /// Same as SurfaceMesh::computeFacesInclusionsInBall, but for all
+    /// the faces close to \a p.
+    ///
+    /// @param r a non-negative radius.
+    /// @param p the center of the ball.
+    /// @return the faces with a positive inclusion ratio in the ball
+    /// (see SurfaceMesh::faceInclusionRatio), sorted by increasing
+    /// index, with their ratio.
+    WeightedFaces computeFacesInclusionsInBall( Scalar r, const RealPoint & p ) const;
+
+    /// Same as SurfaceMesh::computeCellsInclusionsInBall, but for all
+    /// the faces close to \a p.
+    ///
+    /// @param r a non-negative radius.
+    /// @param p the center of the ball.
+    /// @return the vertices included in the ball, the edges and the
+    /// faces with a positive inclusion ratio, with their ratio.
+    std::tuple< Vertices, WeightedEdges, WeightedFaces >
+    computeCellsInclusionsInBall( Scalar r, const RealPoint & p ) const;
+
+    /// @param p any point.
+    /// @return the face nearest to \a p with its distance to \a p, or
+    /// `(nbFaces(), infinity)` if the mesh has no faces.
+    FaceDistance nearestFace( const RealPoint & p ) const;
+
+    /// Batched version of facesInBall, processed in parallel.
+    /// @param p any range of points.
+    /// @param r a non-negative radius.
+    /// @return for each point, the faces at distance at most \a r.
+    std::vector< Faces > facesInBalls( const RealPoints & p, Scalar r ) const;
+
+    /// Batched version of nearestFace, processed in parallel.
+    /// @param p any range of points.
+    /// @return for each point, its nearest face and their distance.
+    std::vector< FaceDistance > nearestFaces( const RealPoints & p ) const;
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+    /// The indexed mesh.
+    const SurfaceMesh* myMesh;
+    /// The edge length of grid cells.
+    Scalar myCellSize;
+    /// The lowest corner of the grid.
+    RealPoint myOrigin;
+    /// The number of cells of the grid along each axis.
+    CellCoordinates myExtent;
+    /// The sorted codes of non-empty cells.
+    std::vector< CellCode > myCellCodes;
+    /// For each non-empty cell, the offset of its range in myCellFaces
+    /// (size is myCellCodes.size()+1).
+    std::vector< Index > myCellOffsets;
+    /// The faces of each non-empty cell.
+    Faces myCellFaces;
+    /// For each face, 'true' if it was invalidated since the last build.
+    std::vector< bool > myIsInvalidated;
+    /// The faces invalidated since the last build.
+    Faces myInvalidatedFaces;
+
+    // ------------------------- Internals ------------------------------------
+  private:
+
+    /// @param p any point.
+    /// @return the coordinates of the grid cell containing \a p, or
+    /// of the nearest cell if \a p is outside the grid.
+    CellCoordinates cellCoordinates( const RealPoint & p ) const;
+
+    /// @param c the coordinates of a grid cell.
+    /// @return its code.
+    static CellCode cellCode( const CellCoordinates & c );
+
+    /// @param c the code of a grid cell.
+    /// @return its coordinates.
+    static CellCoordinates cellCoordinates( CellCode c );
+
+    /// Computes the bounding box of a face.
+    /// @param f any face.
+    /// @param[out] lo the lowest point of its bounding box.
+    /// @param[out] up the uppest point of its bounding box.
+    void faceBoundingBox( Face f, RealPoint & lo, RealPoint & up ) const;
+
+    /// Calls `visitor( f )` for every face whose bounding box may
+    /// intersect the given box (possibly several times per face).
+    /// @param lo the lowest point of the box.
+    /// @param up the uppest point of the box.
+    /// @param visitor any function or functor taking a Face.
+    template < typename FaceVisitor >
+    void visitFacesInBox( const RealPoint & lo, const RealPoint & up,
+                          FaceVisitor visitor ) const;
+
+    /// @param p any point.
+    /// @param r a non-negative radius.
+    /// @return the faces whose bounding box intersects the ball of
+    /// center \a p and radius \a r, sorted by increasing index.
+    Faces candidateFacesInBall( const RealPoint & p, Scalar r ) const;
+
+    /// @param p any point.
+    /// @param a any point.
+    /// @param b any point.
+    /// @param c any point.
+    /// @return the squared distance between \a p and the triangle (a,b,c).
+    static Scalar squaredDistanceToTriangle( const RealPoint & p, const RealPoint & a,
+                                             const RealPoint & b, const RealPoint & c );
+
+    /// @param p any point.
+    /// @param a any point.
+    /// @param b any point.
+    /// @return the squared distance between \a p and the segment [a,b].
+    static Scalar squaredDistanceToSegment( const RealPoint & p, const RealPoint & a,
+                                            const RealPoint & b );
+
+  }; // end of class SurfaceMeshSpatialIndex
+
+
+  /**
+     Overloads 'operator<<' for displaying objects of class 'SurfaceMeshSpatialIndex'.
+     @param out the output stream where the object is written.
+     @param object the object of class 'SurfaceMeshSpatialIndex' to write.
+     @return the output stream after the writing.
+   */
+  template <typename TRealPoint, typename TRealVector>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const SurfaceMeshSpatialIndex<TRealPoint, TRealVector> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/shapes/SurfaceMeshSpatialIndex.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined SurfaceMeshSpatialIndex_h
+
+#undef SurfaceMeshSpatialIndex_RECURSES
+#endif // else defined(SurfaceMeshSpatialIndex_RECURSES)
@@ -169,6 +169,14 @@ namespace DGtal
   * (strangely) not models of boost::AssociativeContainer, hence we
   * cannot check concepts here.
   *
+  * @note When compiled with OpenMP (WITH_OPENMP), the global
+  * operations close(), open(), interior(), boundary(),
+  * getInteriorAndBoundary(), closure() and star() visit the cells of
+  * each dimension in parallel. Each thread gathers its results in its
+  * own buffer, and buffers are merged sequentially into the cell
+  * maps, so that any associative container can be used without
+  * locking.
+  *
   */
   template < typename TKSpace,
              typename TCellContainer = typename TKSpace::template CellMap< CubicalCellData >::Type >
@@ -1311,6 +1319,24 @@ namespace DGtal
     // ------------------------- Internals ------------------------------------
   private:
 
+    /**
+     * Visits the cells of dimension \a d of the complex \a X, in
+     * parallel when OpenMP is available. The visitor outputs values
+     * in the buffer of the calling thread, buffers are returned for
+     * a sequential merge, so that cell maps are never modified
+     * concurrently.
+     *
+     * @tparam Value the type of output values.
+     * @tparam CellMapVisitor the type of a functor (CellMapConstIterator, std::vector<Value>&) -> void.
+     *
+     * @param X any cubical complex (generally this one or a copy).
+     * @param d any dimension.
+     * @param visitor the functor called on each cell of dimension \a d of \a X.
+     * @return the buffers filled by the visitor, one per thread.
+     */
+    template <typename Value, typename CellMapVisitor>
+    static std::vector< std::vector< Value > >
+    visitCells( const CubicalComplex& X, Dimension d, CellMapVisitor visitor );
 
   }; // end of class CubicalComplex
 
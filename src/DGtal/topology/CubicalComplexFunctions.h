@@ -363,6 +363,10 @@ namespace DGtal
      * @note Only cells that are in the closure of [\a S_itb,\a S_itE)
      * may be removed, and only if they are not marked as FIXED.
      *
+     * @note With OpenMP, the faces of the starting cells are computed
+     * in parallel (when \a hintIsSClosed is 'false'). The collapsing
+     * loop follows the priority order, hence remains sequential.
+     *
      * @advanced If you use a DefaultCellMapIteratorPriority object as
      * \a priority, then the VALUE part of each cell data defines the
      * priority (the highest value the soonest are these cells
@@ -0,0 +1,455 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file FlatDigitalSurface.h
+ *
+ * Header file for module FlatDigitalSurface.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(FlatDigitalSurface_RECURSES)
+#error Recursive header files inclusion detected in FlatDigitalSurface.h
+#else // defined(FlatDigitalSurface_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define FlatDigitalSurface_RECURSES
+
+#if !defined FlatDigitalSurface_h
+/** Prevents repeated inclusion of headers. */
+#define FlatDigitalSurface_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include <limits>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/ConstAlias.h"
+#include "DGtal/kernel/CPointPredicate.h"
+#include "DGtal/topology/Topology.h"
+#include "DGtal/topology/SurfelAdjacency.h"
+#include "DGtal/topology/SurfelNeighborhood.h"
+#include "DGtal/topology/KhalimskyCellPacker.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class FlatDigitalSurface
+  /**
+     Description of template class 'FlatDigitalSurface' <p> \brief
+     Aim: A model of CDigitalSurfaceContainer which stores the whole
+     boundary of a shape given by a point predicate (e.g. a binary
+     image) in flat arrays, in the spirit of a compressed sparse row
+     (CSR) graph.
+
+     Surfels are stored in a vector sorted by their linearized
+     Khalimsky code (Khalimsky coordinates relative to the lower cell
+     of the space, last coordinate varying the slowest). Each surfel
+     has a 32-bit index, and its 2(n-1) neighbors along the surface,
+     together with their move codes (see
+     SurfelNeighborhood::getAdjacentOnPointPredicate), are stored in
+     contiguous arrays. Consequently, the tracker of this container
+     computes adjacent surfels in O(1) without accessing the shape,
+     and moving the tracker to an adjacent surfel is O(1). Locating
+     an arbitrary surfel (isInside, index) is a binary search on the
+     codes, no hashing is involved.
+
+     The container is built in one pass over the Khalimsky slabs of
+     the last coordinate, which is parallelized with OpenMP when
+     available, then the neighbor arrays are filled in parallel. All
+     the boundary components of the shape within the space are
+     stored, hence connectedness() may be DISCONNECTED. The connected
+     components are labelled with a concurrent (lock-free) union-find
+     over the neighbor arrays, see nbComponents() and component().
+
+     @tparam TKSpace a model of CCellularGridSpaceND: the type chosen
+     for the cellular grid space. The space should not be periodic.
+
+     @code
+     typedef FlatDigitalSurface< Z3i::KSpace > SurfaceContainer;
+     typedef DigitalSurface< SurfaceContainer > Surface;
+     Surface surface( new SurfaceContainer( K, image, SurfelAdjacency<3>( true ) ) );
+     @endcode
+   */
+  template < typename TKSpace >
+  class FlatDigitalSurface
+  {
+  public:
+
+    /**
+       A model of CDigitalSurfaceTracker for FlatDigitalSurface. It
+       only stores the index of the current surfel.
+    */
+    class Tracker
+    {
+    public:
+      // -------------------- associated types --------------------
+      typedef Tracker Self;
+      typedef FlatDigitalSurface<TKSpace> DigitalSurfaceContainer;
+      typedef typename TKSpace::SCell Surfel;
+
+      // -------------------- inner types --------------------
+      typedef TKSpace KSpace;
+      typedef uint32_t Index;
+
+    public:
+      /**
+	 Constructor from surface container and surfel.
+	 @param aSurface the container describing the surface.
+	 @param s the surfel on which the tracker is initialized.
+         @pre 'aSurface.isInside( s )'
+      */
+      Tracker( ConstAlias<DigitalSurfaceContainer> aSurface,
+               const Surfel & s );
+
+      /**
+	 Copy constructor.
+	 @param other the object to clone.
+      */
+      Tracker( const Tracker & other );
+
+      /**
+       * Destructor.
+       */
+      ~Tracker();
+
+      /// @return the surface container that the Tracker is tracking.
+      const DigitalSurfaceContainer & surface() const;
+      /// @return the current surfel on which the tracker is.
+      const Surfel & current() const;
+      /// @return the index of the current surfel in the surface container.
+      Index currentIndex() const;
+      /// @return the orthogonal direction to the current surfel.
+      Dimension orthDir() const;
+
+      /**
+	 Moves the tracker to the given valid surfel. O(1) if @a s is
+	 adjacent to the current surfel, O(log n) otherwise.
+	 @pre 'surface().isInside( s )'
+	 @param s the surfel on which the tracker is moved.
+      */
+      void move( const Surfel & s );
+
+      /**
+	 Computes the surfel adjacent to 'current()' in the direction
+	 [d] along orientation [pos]. O(1), it is a lookup in the
+	 neighbor arrays of the container.
+
+	 @param s (modified) set to the adjacent surfel in the specified
+	 direction @a d and orientation @a pos if it exists. Otherwise
+	 unchanged (method returns 0 in this case).
+
+	 @param d any direction different from 'orthDir()'.
+
+	 @param pos when 'true' look in positive direction along
+	 [track_dir] axis, 'false' look in negative direction.
+
+	 @return the move code (n=0-3). When 0: no adjacent surfel,
+	 otherwise 1-3: adjacent surfel is n-th follower.
+      */
+      uint8_t adjacent( Surfel & s, Dimension d, bool pos ) const;
+
+    private:
+      /// a pointer to the digital surface container on which is the
+      /// tracker.
+      const DigitalSurfaceContainer* mySurface;
+      /// the index of the current surfel.
+      Index myIndex;
+
+    };
+
+    // ----------------------- associated types ------------------------------
+  public:
+    typedef FlatDigitalSurface<TKSpace> Self;
+    /// Model of cellular grid space.
+    typedef TKSpace KSpace;
+    /// Type for surfels.
+    typedef typename KSpace::SCell Surfel;
+    /// Type for sizes (unsigned integral type).
+    typedef typename KSpace::Size Size;
+
+    // -------------------- specific types ------------------------------
+    typedef typename std::vector<Surfel>::const_iterator SurfelConstIterator;
+    typedef typename KSpace::Space Space;
+    typedef typename KSpace::Point Point;
+    typedef typename KSpace::Integer Integer;
+    typedef Tracker DigitalSurfaceTracker;
+
+    // ----------------------- other types ------------------------------
+  public:
+    typedef SurfelAdjacency<KSpace::dimension> Adjacency;
+    typedef typename KSpace::Cell Cell;
+    typedef typename KSpace::SCell SCell;
+    /// Type for surfel indices.
+    typedef uint32_t Index;
+    /// Type for packing surfels into linearized Khalimsky codes.
+    typedef KhalimskyCellPacker<KSpace, LinearCellPacking> Packer;
+    /// Type for linearized Khalimsky codes.
+    typedef typename Packer::Code Code;
+
+    /// The index returned for surfels that are not in the surface.
+    static constexpr Index InvalidIndex = std::numeric_limits<Index>::max();
+    /// The number of neighbor slots of each surfel.
+    static constexpr Dimension nbSlots = 2 * ( KSpace::dimension - 1 );
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Destructor.
+     */
+    ~FlatDigitalSurface();
+
+    /**
+       Copy constructor.
+       @param other the object to clone.
+     */
+    FlatDigitalSurface( const FlatDigitalSurface & other );
+
+    /**
+       Constructor from a point predicate. Extracts all the surfels
+       of the space that separate a point inside the shape from a
+       point outside, with the inside spel as direct incident spel.
+
+       @tparam TPointPredicate a model of concepts::CPointPredicate,
+       for instance a binary image. It should be thread-safe when
+       OpenMP is used.
+
+       @param aKSpace a cellular grid space (referenced).
+       @param pp the point predicate defining the shape (only used
+       during construction).
+       @param adj the surfel adjacency (for instance Adjacency( true )
+       is interior to exterior adjacency ).
+    */
+    template <typename TPointPredicate>
+    FlatDigitalSurface( ConstAlias<KSpace> aKSpace,
+                        const TPointPredicate & pp,
+                        const Adjacency & adj );
+
+    /// accessor to surfel adjacency.
+    const Adjacency & surfelAdjacency() const;
+
+    // --------- CDigitalSurfaceContainer realization -------------------------
+  public:
+
+    /// @return the cellular space in which lives the surface.
+    const KSpace & space() const;
+    /**
+       @param s any surfel of the space.
+       @return 'true' if @a s belongs to this digital surface. O(log n).
+    */
+    bool isInside( const Surfel & s ) const;
+
+    /// @return an iterator pointing on the first surfel of the
+    /// digital surface (increasing codes).
+    SurfelConstIterator begin() const;
+
+    /// @return an iterator after the last surfel of the digital surface.
+    SurfelConstIterator end() const;
+
+    /// @return the number of surfels of this digital surface. NB:
+    /// O(1)
+    Size nbSurfels() const;
+
+    /// @return 'true' is the surface has no surfels, 'false'
+    /// otherwise. NB: O(1) operation.
+    bool empty() const;
+
+    /**
+       @param s any surfel of the space.
+       @pre 'isInside( s )'
+       @return a dyn. alloc. pointer on a tracker positionned at @a s.
+    */
+    DigitalSurfaceTracker* newTracker( const Surfel & s ) const;
+
+    /**
+       @return the connectedness of this surface. Either CONNECTED or
+       DISCONNECTED (computed at construction). O(1).
+    */
+    Connectedness connectedness() const;
+
+    // ----------------------- Index services --------------------------------
+  public:
+
+    /**
+       @param s any surfel of the space.
+       @return the index of @a s in this container, or InvalidIndex if
+       @a s is not a surfel of the surface. O(log n).
+    */
+    Index index( const Surfel & s ) const;
+
+    /**
+       @param i any valid index.
+       @return the surfel of index @a i.
+    */
+    const Surfel & surfel( Index i ) const;
+
+    /**
+       @param i any valid index.
+       @return the orthogonal direction of the surfel of index @a i.
+    */
+    Dimension orthDir( Index i ) const;
+
+    /**
+       @param i any valid index.
+       @param d any direction different from 'orthDir( i )'.
+       @param pos when 'true' look in positive direction along @a d.
+       @return the index of the surfel adjacent to the surfel @a i in
+       the given direction, or InvalidIndex if there is none. O(1).
+    */
+    Index neighbor( Index i, Dimension d, bool pos ) const;
+
+    /**
+       @param i any valid index.
+       @param d any direction different from 'orthDir( i )'.
+       @param pos when 'true' look in positive direction along @a d.
+       @return the move code (0-3) to the surfel adjacent to the
+       surfel @a i in the given direction, 0 if there is none. O(1).
+    */
+    uint8_t moveCode( Index i, Dimension d, bool pos ) const;
+
+    /// @return the number of connected components of the surface.
+    Size nbComponents() const;
+
+    /**
+       @param i any valid index.
+       @return the label of the connected component of the surfel of
+       index @a i, between 0 and nbComponents() - 1. Components are
+       numbered by increasing index of their first surfel.
+    */
+    Index component( Index i ) const;
+
+    /**
+       @param s any signed surfel of the space.
+       @return the linearized Khalimsky code of @a s, in which the
+       sign is the least significant bit (see KhalimskyCellPacker).
+    */
+    Code code( const Surfel & s ) const;
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+    /// a reference to the cellular space.
+    const KSpace & myKSpace;
+    /// the surfel adjacency used to determine neighbors.
+    Adjacency mySurfelAdjacency;
+    /// the packer that computes the codes of surfels.
+    Packer myPacker;
+    /// the surfels sorted by increasing codes.
+    std::vector<Surfel> mySurfels;
+    /// the codes of the surfels (same order as mySurfels).
+    std::vector<Code> myCodes;
+    /// the orthogonal directions of the surfels.
+    std::vector<uint8_t> myOrthDirs;
+    /// the nbSlots neighbor indices of each surfel, contiguous.
+    std::vector<Index> myNeighbors;
+    /// the nbSlots move codes of each surfel, contiguous.
+    std::vector<uint8_t> myMoveCodes;
+    /// the component label of each surfel.
+    std::vector<Index> myComponents;
+    /// the number of connected components.
+    Size myNbComponents;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * Assignment.
+     * @param other the object to copy.
+     * @return a reference on 'this'.
+     * Forbidden by default.
+     */
+    FlatDigitalSurface & operator= ( const FlatDigitalSurface & other );
+
+    // ------------------------- Internals ------------------------------------
+  private:
+
+    /**
+       Extracts the boundary surfels of the shape, sorted by codes.
+       @param pp the point predicate defining the shape.
+    */
+    template <typename TPointPredicate>
+    void extractSurfels( const TPointPredicate & pp );
+
+    /**
+       Computes the neighbor and move code arrays.
+       @param pp the point predicate defining the shape.
+    */
+    template <typename TPointPredicate>
+    void computeNeighbors( const TPointPredicate & pp );
+
+    /// Labels the connected components of the surface with a
+    /// concurrent union-find over the neighbor arrays.
+    void computeComponents();
+
+    /**
+       @param i any valid index.
+       @param d any direction different from 'orthDir( i )'.
+       @param pos when 'true' positive direction along @a d.
+       @return the position of the given neighbor slot in myNeighbors.
+    */
+    std::size_t slot( Index i, Dimension d, bool pos ) const;
+
+  }; // end of class FlatDigitalSurface
+
+
+  /**
+     Overloads 'operator<<' for displaying objects of class 'FlatDigitalSurface'.
+     @param out the output stream where the object is written.
+     @param object the object of class 'FlatDigitalSurface' to write.
+     @return the output stream after the writing.
+
+     @tparam TKSpace a model of CCellularGridSpaceND: the type chosen
+     for the cellular grid space.
+   */
+  template <typename TKSpace>
+  std::ostream&
+  operator<< ( std::ostream & out,
+	       const FlatDigitalSurface<TKSpace> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/topology/FlatDigitalSurface.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined FlatDigitalSurface_h
+
+#undef FlatDigitalSurface_RECURSES
+#endif // else defined(FlatDigitalSurface_RECURSES)
@@ -0,0 +1,313 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file KhalimskyCellPacker.h
+ *
+ * Header file for module KhalimskyCellPacker.ih
+ *
+ * This file is part of the DGtal library.
+ */
+
+#if defined(KhalimskyCellPacker_RECURSES)
+#error Recursive header files inclusion detected in KhalimskyCellPacker.h
+#else // defined(KhalimskyCellPacker_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define KhalimskyCellPacker_RECURSES
+
+#if !defined KhalimskyCellPacker_h
+/** Prevents repeated inclusion of headers. */
+#define KhalimskyCellPacker_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <array>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/ConstAlias.h"
+#include "DGtal/topology/KhalimskySpaceND.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /**
+   * @brief Tag (empty structure) specifying a linear packing of
+   * Khalimsky coordinates: one bit field per coordinate, the last
+   * coordinate being the most significant one.
+   */
+  struct LinearCellPacking {};
+
+  /**
+   * @brief Tag (empty structure) specifying a Morton (Z-order)
+   * packing of Khalimsky coordinates: the bits of the coordinates are
+   * interleaved.
+   */
+  struct MortonCellPacking {};
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class KhalimskyCellPacker
+  /**
+     Description of template class 'KhalimskyCellPacker' <p> \brief
+     Aim: Packs the cells of a bounded Khalimsky space into 64-bit
+     codes, and unpacks them.
+
+     The Khalimsky coordinates of a cell, relative to the lower cell of
+     the space, are stored in bit fields that are either concatenated
+     (LinearCellPacking) or interleaved (MortonCellPacking). The code
+     of a signed cell is the code of its unsigned cell shifted by one
+     bit, the least significant bit being the sign (1 for POS).
+
+     A code takes 8 bytes whatever the dimension, so that containers
+     of codes are much lighter than containers of cells, and codes are
+     compared and hashed as integers. The functors Less and Hash order
+     and hash cells through their codes, for std::set,
+     std::unordered_set and the like.
+
+     With LinearCellPacking, codes are ordered as the Khalimsky
+     coordinates in lexicographic order, last coordinate first, and
+     (un)packing is a few shifts. With MortonCellPacking, close cells
+     have close codes, which improves locality when sorting, but
+     (un)packing loops over bits.
+
+     @note The space must be small enough for the codes to fit in 63
+     bits (see isValid()), e.g. a 3D space of extent up to 2^20 per
+     axis with LinearCellPacking.
+
+     @tparam TKSpace the type of cellular grid space, a
+     KhalimskySpaceND.
+     @tparam TPacking either LinearCellPacking or MortonCellPacking.
+
+     @code
+     KhalimskyCellPacker< Z3i::KSpace > packer( K );
+     std::unordered_set< Z3i::Cell, decltype( packer )::Hash > cells( 0, packer.hash() );
+     const auto c = packer.code( K.uSpel( Z3i::Point( 1, 2, 3 ) ) );
+     ASSERT( packer.cell( c ) == K.uSpel( Z3i::Point( 1, 2, 3 ) ) );
+     @endcode
+   */
+  template < typename TKSpace,
+             typename TPacking = LinearCellPacking >
+  class KhalimskyCellPacker
+  {
+  public:
+    typedef KhalimskyCellPacker<TKSpace, TPacking> Self;
+    typedef TKSpace KSpace;
+    typedef TPacking Packing;
+    typedef typename KSpace::Integer Integer;
+    typedef typename KSpace::Point Point;
+    typedef typename KSpace::Cell Cell;
+    typedef typename KSpace::SCell SCell;
+    /// The type of codes.
+    typedef uint64_t Code;
+
+    static const Dimension dimension = KSpace::dimension;
+
+    /**
+       Functor that hashes cells or signed cells through their codes
+       (plus a bit mixing), for unordered containers.
+    */
+    struct Hash
+    {
+      /// Default constructor, invalid hasher.
+      Hash() : myPacker( nullptr ) {}
+      /// Constructor from packer (aliased).
+      /// @param packer the packer that computes the codes.
+      Hash( ConstAlias<Self> packer ) : myPacker( &packer ) {}
+      /// @param c any cell of the space.
+      /// @return the hash value of @a c.
+      std::size_t operator()( const Cell & c ) const
+      { return Self::hashCode( myPacker->code( c ) ); }
+      /// @param c any signed cell of the space.
+      /// @return the hash value of @a c.
+      std::size_t operator()( const SCell & c ) const
+      { return Self::hashCode( myPacker->code( c ) ); }
+      /// the packer that computes the codes.
+      const Self* myPacker;
+    };
+
+    /**
+       Functor that orders cells or signed cells by their codes, for
+       ordered containers.
+    */
+    struct Less
+    {
+      /// Default constructor, invalid comparator.
+      Less() : myPacker( nullptr ) {}
+      /// Constructor from packer (aliased).
+      /// @param packer the packer that computes the codes.
+      Less( ConstAlias<Self> packer ) : myPacker( &packer ) {}
+      /// @param c1 any cell of the space.
+      /// @param c2 any cell of the space.
+      /// @return 'true' iff the code of @a c1 is smaller than the one of @a c2.
+      bool operator()( const Cell & c1, const Cell & c2 ) const
+      { return myPacker->code( c1 ) < myPacker->code( c2 ); }
+      /// @param c1 any signed cell of the space.
+      /// @param c2 any signed cell of the space.
+      /// @return 'true' iff the code of @a c1 is smaller than the one of @a c2.
+      bool operator()( const SCell & c1, const SCell & c2 ) const
+      { return myPacker->code( c1 ) < myPacker->code( c2 ); }
+      /// the packer that computes the codes.
+      const Self* myPacker;
+    };
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+       Constructor from a bounded space.
+       @param aKSpace the cellular grid space (aliased).
+    */
+    KhalimskyCellPacker( ConstAlias<KSpace> aKSpace );
+
+    /// @return the cellular grid space.
+    const KSpace & space() const;
+
+    /// @return the number of bits used by the codes of unsigned
+    /// cells (one more for signed cells).
+    unsigned int nbBits() const;
+
+    /// @return a hash functor using this packer.
+    Hash hash() const;
+
+    /// @return a comparison functor using this packer.
+    Less less() const;
+
+    // ----------------------- Packing services ------------------------------
+  public:
+
+    /**
+       @param kp the Khalimsky coordinates of a cell of the space.
+       @return the code of the unsigned cell with coordinates @a kp.
+    */
+    Code code( const Point & kp ) const;
+
+    /**
+       @param c any cell of the space.
+       @return its code.
+    */
+    Code code( const Cell & c ) const;
+
+    /**
+       @param c any signed cell of the space.
+       @return its code, whose least significant bit is the sign.
+    */
+    Code code( const SCell & c ) const;
+
+    /**
+       @param c any code of an unsigned cell.
+       @return the Khalimsky coordinates of the corresponding cell.
+    */
+    Point kCoords( Code c ) const;
+
+    /**
+       @param c any code of an unsigned cell.
+       @return the corresponding cell.
+    */
+    Cell cell( Code c ) const;
+
+    /**
+       @param c any code of a signed cell.
+       @return the corresponding signed cell.
+    */
+    SCell sCell( Code c ) const;
+
+    /**
+       Mixes the bits of a code, so that codes of close cells have
+       unrelated hash values.
+       @param c any code.
+       @return a hash value for @a c.
+    */
+    static std::size_t hashCode( Code c );
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the codes of all the signed cells of the
+     * space fit in 64 bits, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+    /// a pointer to the cellular grid space.
+    const KSpace* myKSpace;
+    /// the Khalimsky coordinates of the lower cell of the space.
+    Point myLowerKCoords;
+    /// the number of bits of each coordinate.
+    std::array<unsigned int, dimension> myBits;
+    /// the shifts of each coordinate (linear packing).
+    std::array<unsigned int, dimension> myShifts;
+    /// the total number of bits of unsigned codes.
+    unsigned int myNbBits;
+
+    // ------------------------- Internals ------------------------------------
+  private:
+
+    /// Packs relative coordinates (linear packing).
+    /// @param x the coordinates relative to the lower cell.
+    /// @return the code.
+    Code pack( const std::array<Code, dimension> & x, LinearCellPacking ) const;
+    /// Packs relative coordinates (Morton packing).
+    /// @param x the coordinates relative to the lower cell.
+    /// @return the code.
+    Code pack( const std::array<Code, dimension> & x, MortonCellPacking ) const;
+    /// Unpacks relative coordinates (linear packing).
+    /// @param c the code.
+    /// @param[out] x the coordinates relative to the lower cell.
+    void unpack( Code c, std::array<Code, dimension> & x, LinearCellPacking ) const;
+    /// Unpacks relative coordinates (Morton packing).
+    /// @param c the code.
+    /// @param[out] x the coordinates relative to the lower cell.
+    void unpack( Code c, std::array<Code, dimension> & x, MortonCellPacking ) const;
+
+  }; // end of class KhalimskyCellPacker
+
+
+  /**
+     Overloads 'operator<<' for displaying objects of class 'KhalimskyCellPacker'.
+     @param out the output stream where the object is written.
+     @param object the object of class 'KhalimskyCellPacker' to write.
+     @return the output stream after the writing.
+   */
+  template <typename TKSpace, typename TPacking>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const KhalimskyCellPacker<TKSpace, TPacking> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/topology/KhalimskyCellPacker.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined KhalimskyCellPacker_h
+
+#undef KhalimskyCellPacker_RECURSES
+#endif // else defined(KhalimskyCellPacker_RECURSES)
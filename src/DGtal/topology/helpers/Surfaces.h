@@ -613,6 +613,10 @@ namespace DGtal
        default cell orientation in order to get the direction of shape
        exterior (default =false). This is used only for displaying
        cells with Viewer3D. This mechanism should evolve shortly.
+
+       @note When no dimension of @a aKSpace is periodic, the boundary
+       is extracted and labelled in parallel (see FlatDigitalSurface),
+       so @a pp must be thread-safe when OpenMP is used.
     */
     template <typename PointPredicate >
     static 
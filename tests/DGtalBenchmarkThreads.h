@@ -0,0 +1,74 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file DGtalBenchmarkThreads.h
+ * @ingroup Tests
+ * @brief Helpers shared by the thread scaling benchmarks.
+ *
+ * This file is part of the DGtal library.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "DGtal/base/Common.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @param maxThreads the maximal number of threads.
+ * @return the increasing thread counts 1, 2, 4, ..., ending with @a maxThreads.
+ */
+inline std::vector<int> benchmarkThreadCounts( int maxThreads )
+{
+  std::vector<int> counts;
+  for ( int nbThreads = 1; nbThreads < maxThreads; nbThreads *= 2 )
+    counts.push_back( nbThreads );
+  counts.push_back( std::max( maxThreads, 1 ) );
+  return counts;
+}
+
+/**
+ * Runs a benchmark for each count of benchmarkThreadCounts (up to the
+ * number of available threads) and displays the speedup with respect
+ * to the first run. Without OpenMP, the benchmark is run once.
+ *
+ * @param run a callable object returning the elapsed time of one run.
+ */
+template <typename Run>
+void benchmarkThreadScaling( Run run )
+{
+#ifdef WITH_OPENMP
+  double reference = 0.;
+  for ( int nbThreads : benchmarkThreadCounts( omp_get_max_threads() ) )
+    {
+      omp_set_num_threads( nbThreads );
+      DGtal::trace.beginBlock( "Threads: " + std::to_string( nbThreads ) );
+      const double time = run();
+      if ( nbThreads == 1 )
+        reference = time;
+      DGtal::trace.info() << "Speedup = " << reference / time << std::endl;
+      DGtal::trace.endBlock();
+    }
+#else
+  DGtal::trace.warning() << "DGtal built without OpenMP: sequential run only." << std::endl;
+  run();
+#endif
+}
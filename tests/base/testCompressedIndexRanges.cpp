@@ -0,0 +1,85 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testCompressedIndexRanges.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class CompressedIndexRanges.
+ *
+ * This file is part of the DGtal library.
+ */
+
+#include "DGtalCatch.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "DGtal/base/CompressedIndexRanges.h"
+
+using namespace DGtal;
+
+TEST_CASE( "Testing CompressedIndexRanges" )
+{
+  typedef CompressedIndexRanges< std::size_t > Ranges;
+  typedef Ranges::Indices                      Indices;
+  const std::vector< Indices > input = { { 0, 1, 2 }, { }, { 3, 4 }, { 5 } };
+  Ranges ranges( input.cbegin(), input.cend() );
+
+  SECTION( "Ranges are stored as given" )
+    {
+      REQUIRE( ranges.isValid() );
+      REQUIRE( ranges.size() == 4 );
+      REQUIRE( ranges.nbIndices() == 6 );
+      REQUIRE( ranges[ 1 ].empty() );
+      REQUIRE( ranges[ 2 ].front() == 3 );
+      REQUIRE( ranges[ 2 ].back()  == 4 );
+      for ( std::size_t r = 0; r < input.size(); ++r )
+        REQUIRE( ranges[ r ] == input[ r ] );
+      REQUIRE( std::vector< Indices >( ranges ) == input );
+      REQUIRE( std::equal( ranges.begin(), ranges.end(), input.cbegin() ) );
+    }
+
+  SECTION( "Ranges may be built from their sizes then filled" )
+    {
+      const std::vector< std::size_t > sizes = { 3, 0, 2, 1 };
+      Ranges other;
+      other.resize( sizes.cbegin(), sizes.cend() );
+      std::size_t i = 0;
+      for ( std::size_t r = 0; r < sizes.size(); ++r )
+        for ( std::size_t k = 0; k < sizes[ r ]; ++k )
+          other.at( r, k ) = i++;
+      REQUIRE( std::vector< Indices >( other ) == input );
+    }
+
+  SECTION( "Edited ranges are seen through views and merged by compact()" )
+    {
+      ranges.add( 1, 7 );
+      REQUIRE( ranges.remove( 0, 1 ) );
+      REQUIRE( ! ranges.remove( 0, 8 ) );
+      REQUIRE( ranges.replace( 3, 5, 6 ) );
+      REQUIRE( ! ranges.replace( 3, 5, 6 ) );
+      const std::vector< Indices > expected = { { 0, 2 }, { 7 }, { 3, 4 }, { 6 } };
+      REQUIRE( ranges.nbIndices() == 6 );
+      REQUIRE( std::vector< Indices >( ranges ) == expected );
+      ranges.compact();
+      REQUIRE( ranges.isValid() );
+      REQUIRE( std::vector< Indices >( ranges ) == expected );
+      ranges.push_back( input[ 0 ].cbegin(), input[ 0 ].cend() );
+      REQUIRE( ranges.size() == 5 );
+      REQUIRE( ranges[ 4 ] == input[ 0 ] );
+    }
+}
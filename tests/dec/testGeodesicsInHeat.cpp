@@ -29,6 +29,7 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 #include <iostream>
+#include <sstream>
 #include "DGtal/base/Common.h"
 #include "ConfigTest.h"
 #include "DGtalCatch.h"
@@ -88,5 +89,66 @@ TEST_CASE( "Testing GeodesicsInHeat" )
     auto sources = heat.source();
     REQUIRE(sources.sum() == 0);
   }
+
+  SECTION("Batched sources and saved prefactorization")
+  {
+    typedef GeodesicsInHeat<PolygonalCalculus<RealPoint,RealVector>> Heat;
+    Heat heat(boxCalculus);
+    heat.init(0.1, 1.0, true);
+    std::vector<Heat::Vertex> seeds = { 0, 5, 9, 3, 7 };
+    Heat::DenseMatrix batch = heat.computeBatch( seeds );
+    REQUIRE( batch.cols() == (Eigen::Index)seeds.size() );
+    Heat::DenseMatrix sequential = heat.computeBatch( seeds, false );
+    REQUIRE( ( batch - sequential ).norm() == Approx( 0.0 ).margin( 1e-12 ) );
+    for ( size_t k = 0; k < seeds.size(); ++k )
+    {
+      heat.clearSource();
+      heat.addSource( seeds[ k ] );
+      Heat::Vector d = heat.compute();
+      REQUIRE( ( batch.col( k ) - d ).norm() == Approx( 0.0 ).margin( 1e-10 ) );
+      REQUIRE( d[ seeds[ k ] ] == Approx( 0.0 ).margin( 1e-12 ) );
+    }
+
+    std::stringstream buffer;
+    REQUIRE( heat.save( buffer ) );
+    Heat reloaded(boxCalculus);
+    REQUIRE( reloaded.load( buffer ) );
+    REQUIRE( reloaded.isValid() );
+    Heat::DenseMatrix batchReloaded = reloaded.computeBatch( seeds );
+    REQUIRE( ( batch - batchReloaded ).norm() == Approx( 0.0 ).margin( 1e-12 ) );
+
+    std::stringstream truncated( buffer.str().substr( 0, 10 ) );
+    Heat invalid(boxCalculus);
+    REQUIRE( ! invalid.load( truncated ) );
+    REQUIRE( ! invalid.isValid() );
+
+    // Out of range row index in the first factor (after the header,
+    // the sizes and the outer indices of the heat factor).
+    typedef Heat::SparseMatrix::StorageIndex StorageIndex;
+    const Eigen::Index nv = boxCalculus.nbVertices();
+    const std::size_t innerPos = 21 + sizeof( Eigen::Index ) + sizeof( double ) + sizeof( bool )
+      + 2 * sizeof( Eigen::Index ) + ( nv + 1 ) * sizeof( StorageIndex );
+    std::string corrupted = buffer.str();
+    const StorageIndex badIndex = (StorageIndex) nv;
+    corrupted.replace( innerPos, sizeof( StorageIndex ),
+                       reinterpret_cast<const char*>( &badIndex ), sizeof( StorageIndex ) );
+    std::stringstream corruptedStream( corrupted );
+    REQUIRE( ! invalid.load( corruptedStream ) );
+    REQUIRE( ! invalid.isValid() );
+  }
+
+  SECTION("Batched sources with the calculus internal cache")
+  {
+    typedef GeodesicsInHeat<PolygonalCalculus<RealPoint,RealVector>> Heat;
+    PolygonalCalculus<RealPoint,RealVector> cachedCalculus(box, true);
+    Heat heat(cachedCalculus);
+    heat.init(0.1, 1.0, true);
+    Heat reference(boxCalculus);
+    reference.init(0.1, 1.0, true);
+    std::vector<Heat::Vertex> seeds = { 0, 5, 9, 3, 7, 1, 8, 2 };
+    Heat::DenseMatrix batch = heat.computeBatch( seeds );
+    Heat::DenseMatrix expected = reference.computeBatch( seeds, false );
+    REQUIRE( ( batch - expected ).norm() == Approx( 0.0 ).margin( 1e-12 ) );
+  }
 }
 /** @ingroup Tests **/
@@ -368,6 +368,44 @@ TEST_CASE( "Testing PolygonalCalculus and DirichletConditions" )
           REQUIRE( max_phi >  max_i_u );
         } //   for ( double scale = 0.1; scale < 2.0; scale *= 2.0 )
     }
+
+  SECTION("Global operators are the sums of the per face operators")
+    {
+      PolyDEC calculusCached( surfmesh, true );
+      const auto nv = surfmesh.nbVertices();
+      PolyDEC::DenseMatrix expectedL  = PolyDEC::DenseMatrix::Zero( nv, nv );
+      PolyDEC::DenseMatrix expectedCL = PolyDEC::DenseMatrix::Zero( 2*nv, 2*nv );
+      PolyDEC::Vector      expectedM  = PolyDEC::Vector::Zero( nv );
+      for ( Index f = 0; f < surfmesh.nbFaces(); ++f )
+        {
+          const auto vertices          = surfmesh.incidentVertices( f );
+          const PolyDEC::DenseMatrix Lf  = calculus.laplaceBeltrami( f );
+          const PolyDEC::DenseMatrix CLf = calculus.connectionLaplacian( f );
+          for ( auto i = 0u; i < vertices.size(); ++i )
+            {
+              expectedM( vertices[ i ] ) += calculus.faceArea( f ) / vertices.size();
+              for ( auto j = 0u; j < vertices.size(); ++j )
+                {
+                  expectedL( vertices[ i ], vertices[ j ] ) += Lf( i, j );
+                  for ( auto k1 = 0u; k1 < 2; ++k1 )
+                    for ( auto k2 = 0u; k2 < 2; ++k2 )
+                      expectedCL( 2*vertices[ i ]+k1, 2*vertices[ j ]+k2 ) += CLf( 2*i+k1, 2*j+k2 );
+                }
+            }
+        }
+      const PolyDEC::SparseMatrix M = calculus.globalLumpedMassMatrix();
+      REQUIRE( ( PolyDEC::DenseMatrix( L ) - expectedL ).norm() == Approx( 0.0 ).margin( 1e-10 ) );
+      REQUIRE( ( PolyDEC::DenseMatrix( calculus.globalConnectionLaplace() ) - expectedCL ).norm()
+               == Approx( 0.0 ).margin( 1e-10 ) );
+      REQUIRE( ( PolyDEC::DenseMatrix( M ).diagonal() - expectedM ).norm() == Approx( 0.0 ).margin( 1e-10 ) );
+      REQUIRE( M.nonZeros() == (long)nv );
+      // The cached calculus gives the same operators, before and after filling its cache.
+      for ( int pass = 0; pass < 2; ++pass )
+        {
+          REQUIRE( ( calculusCached.globalLaplaceBeltrami() - L ).norm() == 0.0 );
+          REQUIRE( ( calculusCached.globalLumpedMassMatrix() - M ).norm() == 0.0 );
+        }
+    }
 };
 
 /** @ingroup Tests **/
@@ -87,6 +87,28 @@ SCENARIO( "CorrectedNormalCurrentComputer interpolated curvature measures on sph
       Approx exact_gaussian_c = Approx( 4.0 * M_PI ).epsilon(0.000005);
       REQUIRE( total_mu2_u == exact_gaussian_c );
     }
+    THEN( "Batched ball measures are the measures of each ball" ) {
+      auto mu0 = cnc_computer.computeMu0();
+      auto mu1 = cnc_computer.computeMu1();
+      std::vector< RealPoint >     centers;
+      std::vector< SM::Face >      faces;
+      for ( SM::Face f = 0; f < sphere.nbFaces(); ++f )
+        {
+          centers.push_back( sphere.faceCentroid( f ) );
+          faces  .push_back( f );
+        }
+      const double R = 0.3;
+      auto balls_mu0 = mu0.measures( centers, R, faces );
+      auto balls_mu1 = mu1.measures( centers, R, faces );
+      REQUIRE( balls_mu0.size() == sphere.nbFaces() );
+      for ( SM::Face f = 0; f < sphere.nbFaces(); ++f )
+        {
+          REQUIRE( balls_mu0[ f ] == Approx( mu0.measure( centers[ f ], R, f ) ) );
+          REQUIRE( balls_mu1[ f ] == Approx( mu1.measure( centers[ f ], R, f ) ) );
+          const double H = CNCComputer::meanCurvature( balls_mu0[ f ], balls_mu1[ f ] );
+          REQUIRE( H == Approx( 1.0 ).epsilon( 0.05 ) );
+        }
+    }
   }
 }
 
@@ -31,6 +31,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include <iostream>
 #include <tuple>
+#include <list>
 
 #include "DGtal/base/Common.h"
 
@@ -275,13 +276,70 @@ bool testPrincipalCurvatures3d( double h )
   return true;
 }
 
+bool testRangeEval3d( double h )
+{
+  typedef ImplicitBall<Z3i::Space> ImplicitShape;
+  typedef GaussDigitizer<Z3i::Space, ImplicitShape> DigitalShape;
+  typedef LightImplicitDigitalSurface<Z3i::KSpace,DigitalShape> Boundary;
+  typedef DigitalSurface< Boundary > MyDigitalSurface;
+  typedef DepthFirstVisitor< MyDigitalSurface > Visitor;
+  typedef GraphVisitorRange< Visitor > VisitorRange;
+
+  typedef functors::IIPrincipalCurvaturesAndDirectionsFunctor<Z3i::Space> MyIICurvatureFunctor;
+  typedef IntegralInvariantCovarianceEstimator< Z3i::KSpace, DigitalShape, MyIICurvatureFunctor > MyIICurvatureEstimator;
+  typedef MyIICurvatureFunctor::Value Value;
+
+  double re = 3.0;
+
+  trace.beginBlock( "Range evaluation (random access vs forward iterators) ..." );
+
+  ImplicitShape ishape( Z3i::RealPoint( 0, 0, 0 ), 5.0 );
+  DigitalShape dshape;
+  dshape.attach( ishape );
+  dshape.init( Z3i::RealPoint( -10.0, -10.0, -10.0 ), Z3i::RealPoint( 10.0, 10.0, 10.0 ), h );
+
+  Z3i::KSpace K;
+  if ( !K.init( dshape.getLowerBound(), dshape.getUpperBound(), true ) )
+  {
+    trace.error() << "Problem with Khalimsky space" << std::endl;
+    return false;
+  }
+
+  Z3i::KSpace::Surfel bel = Surfaces<Z3i::KSpace>::findABel( K, dshape, 10000 );
+  Boundary boundary( K, dshape, SurfelAdjacency<Z3i::KSpace::dimension>( true ), bel );
+  MyDigitalSurface surf ( boundary );
+
+  VisitorRange range( new Visitor( surf, *surf.begin() ));
+  std::vector< Z3i::KSpace::Surfel > surfels( range.begin(), range.end() );
+  std::list< Z3i::KSpace::Surfel > surfelList( surfels.begin(), surfels.end() );
+
+  MyIICurvatureFunctor curvatureFunctor;
+  curvatureFunctor.init( h, re );
+  MyIICurvatureEstimator curvatureEstimator( curvatureFunctor );
+  curvatureEstimator.attach( K, dshape );
+  curvatureEstimator.setParams( re/h );
+  curvatureEstimator.init( h, surfels.begin(), surfels.end() );
+
+  // Random access ranges may be evaluated by chunks (with OpenMP).
+  std::vector< Value > results;
+  curvatureEstimator.eval( surfels.begin(), surfels.end(), std::back_inserter( results ) );
+  std::vector< Value > expected;
+  curvatureEstimator.eval( surfelList.begin(), surfelList.end(), std::back_inserter( expected ) );
+
+  trace.info() << "Nb surfels: " << surfels.size() << std::endl;
+  const bool ok = ( results.size() == surfels.size() ) && ( results == expected );
+  trace.endBlock();
+  return ok;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Standard services - public :
 
 int main( int /*argc*/, char** /*argv*/ )
 {
   trace.beginBlock ( "Testing class IntegralInvariantCovarianceEstimator and 3d functors" );
-    bool res = testGaussianCurvature3d( 0.6, 0.007 ) && testPrincipalCurvatures3d( 0.6 );
+    bool res = testGaussianCurvature3d( 0.6, 0.007 ) && testPrincipalCurvatures3d( 0.6 )
+      && testRangeEval3d( 0.5 );
     trace.emphase() << ( res ? "Passed." : "Error." ) << std::endl;
   trace.endBlock();
   return res ? 0 : 1;
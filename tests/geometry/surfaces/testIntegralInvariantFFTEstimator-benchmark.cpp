@@ -0,0 +1,159 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testIntegralInvariantFFTEstimator-benchmark.cpp
+ * @ingroup Tests
+ *
+ * Benchmark of the Integral Invariant curvature estimations on whole
+ * surfaces, per-surfel convolver (IntegralInvariantVolumeEstimator,
+ * IntegralInvariantCovarianceEstimator) versus FFT
+ * (IntegralInvariantFFTEstimator), on cat10.vol and on digitized balls.
+ * The crossover estimation of IntegralInvariantFFTEstimator is
+ * displayed along with the timings.
+ *
+ * Usage: testIntegralInvariantFFTEstimator-benchmark [gridstep]
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "ConfigTest.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/helpers/Shortcuts.h"
+#include "DGtal/geometry/surfaces/estimation/IIGeometricFunctors.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantVolumeEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantCovarianceEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantFFTEstimator.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+typedef Shortcuts<Z3i::KSpace> SH3;
+typedef SH3::BinaryImage BinaryImage;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for benchmarking class IntegralInvariantFFTEstimator.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Times a II estimator on the whole surface.
+ *
+ * @param estimator the estimator (attached, not initialized).
+ * @param surfels the surfels of the surface.
+ * @param r the digital radius of the kernel.
+ * @param title the title of the timed block.
+ * @return the elapsed time in milliseconds.
+ */
+template <typename Estimator>
+double timeEstimator( Estimator & estimator, const SH3::SurfelRange & surfels,
+                      double r, const std::string & title )
+{
+  std::vector< typename Estimator::Quantity > results;
+  results.reserve( surfels.size() );
+  trace.beginBlock( title );
+  estimator.setParams( r );
+  estimator.init( 1.0, surfels.begin(), surfels.end() );
+  estimator.eval( surfels.begin(), surfels.end(), std::back_inserter( results ) );
+  return trace.endBlock();
+}
+
+/**
+ * Compares the convolver and FFT estimators for mean (volume) and
+ * Gaussian (covariance) curvatures on a binary image.
+ *
+ * @param name the shape name.
+ * @param bimage the binary image.
+ */
+void benchmarkShape( const std::string & name, CountedPtr<BinaryImage> bimage )
+{
+  typedef functors::IIMeanCurvature3DFunctor<Z3i::Space> MeanFunctor;
+  typedef functors::IIGaussianCurvature3DFunctor<Z3i::Space> GaussianFunctor;
+
+  auto params  = SH3::defaultParameters();
+  auto K       = SH3::getKSpace( bimage, params );
+  auto surface = SH3::makeLightDigitalSurface( bimage, K, params );
+  auto surfels = SH3::getSurfelRange( surface, params( "surfaceTraversal", "DepthFirst" ) );
+
+  trace.beginBlock( name );
+  trace.info() << "Domain " << bimage->domain() << " #surfels=" << surfels.size() << std::endl;
+  for ( double r : { 3.0, 6.0, 10.0 } )
+    {
+      trace.beginBlock( "Radius " + std::to_string( r ) );
+      MeanFunctor meanFunctor;
+      meanFunctor.init( 1.0, r );
+      GaussianFunctor gaussianFunctor;
+      gaussianFunctor.init( 1.0, r );
+
+      IntegralInvariantVolumeEstimator< Z3i::KSpace, BinaryImage, MeanFunctor > meanConvolver( meanFunctor );
+      meanConvolver.attach( K, *bimage );
+      IntegralInvariantFFTEstimator< Z3i::KSpace, BinaryImage, MeanFunctor > meanFFT( K, *bimage, meanFunctor );
+      IntegralInvariantCovarianceEstimator< Z3i::KSpace, BinaryImage, GaussianFunctor > gaussianConvolver( gaussianFunctor );
+      gaussianConvolver.attach( K, *bimage );
+      IntegralInvariantFFTEstimator< Z3i::KSpace, BinaryImage, GaussianFunctor > gaussianFFT( K, *bimage, gaussianFunctor );
+
+      const double tMeanConvolver     = timeEstimator( meanConvolver, surfels, r, "Mean curvature, convolver" );
+      const double tMeanFFT           = timeEstimator( meanFFT, surfels, r, "Mean curvature, FFT" );
+      const double tGaussianConvolver = timeEstimator( gaussianConvolver, surfels, r, "Gaussian curvature, convolver" );
+      const double tGaussianFFT       = timeEstimator( gaussianFFT, surfels, r, "Gaussian curvature, FFT" );
+
+      trace.info() << "Mean: FFT speedup = " << tMeanConvolver / tMeanFFT
+                   << " predicted FFT faster = "
+                   << decltype( meanFFT )::isFasterThanConvolver( K, surfels.size(), r ) << std::endl;
+      trace.info() << "Gaussian: FFT speedup = " << tGaussianConvolver / tGaussianFFT
+                   << " predicted FFT faster = "
+                   << decltype( gaussianFFT )::isFasterThanConvolver( K, surfels.size(), r ) << std::endl;
+      trace.endBlock();
+    }
+  trace.endBlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Benchmarking Integral Invariant estimators, convolver vs FFT" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  const double gridstep = argc > 1 ? atof( argv[ 1 ] ) : 0.05;
+
+  auto params = SH3::defaultParameters();
+  benchmarkShape( "cat10", SH3::makeBinaryImage( testPath + "samples/cat10.vol", params ) );
+
+  params( "polynomial", "sphere1" )( "minAABB", -1.5 )( "maxAABB", 1.5 )( "offset", 1.0 );
+  for ( double h : { 2.0 * gridstep, gridstep } )
+    {
+      params( "gridstep", h );
+      auto implicit_shape  = SH3::makeImplicitShape3D( params );
+      auto digitized_shape = SH3::makeDigitizedImplicitShape3D( implicit_shape, params );
+      benchmarkShape( "Ball h=" + std::to_string( h ), SH3::makeBinaryImage( digitized_shape, params ) );
+    }
+
+  trace.endBlock();
+  return 0;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,147 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testIntegralInvariantFFTEstimator.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class IntegralInvariantFFTEstimator.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtalCatch.h"
+
+#include "DGtal/shapes/implicit/ImplicitBall.h"
+#include "DGtal/shapes/GaussDigitizer.h"
+#include "DGtal/topology/LightImplicitDigitalSurface.h"
+#include "DGtal/topology/DigitalSurface.h"
+#include "DGtal/graph/DepthFirstVisitor.h"
+#include "DGtal/graph/GraphVisitorRange.h"
+
+#include "DGtal/geometry/surfaces/estimation/IIGeometricFunctors.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantVolumeEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantCovarianceEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantFFTEstimator.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+typedef ImplicitBall<Z3i::Space> ImplicitShape;
+typedef GaussDigitizer<Z3i::Space, ImplicitShape> DigitalShape;
+typedef LightImplicitDigitalSurface<Z3i::KSpace, DigitalShape> Boundary;
+typedef DigitalSurface<Boundary> MyDigitalSurface;
+typedef DepthFirstVisitor<MyDigitalSurface> Visitor;
+typedef GraphVisitorRange<Visitor> VisitorRange;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class IntegralInvariantFFTEstimator.
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE( "Testing IntegralInvariantFFTEstimator" )
+{
+  const double h = 0.5;
+  ImplicitShape ishape( Z3i::RealPoint( 0, 0, 0 ), 5 );
+  DigitalShape dshape;
+  dshape.attach( ishape );
+  dshape.init( Z3i::RealPoint( -8.0, -8.0, -8.0 ), Z3i::RealPoint( 8.0, 8.0, 8.0 ), h );
+
+  Z3i::KSpace K;
+  REQUIRE( K.init( dshape.getLowerBound(), dshape.getUpperBound(), true ) );
+
+  Z3i::KSpace::Surfel bel = Surfaces<Z3i::KSpace>::findABel( K, dshape, 10000 );
+  Boundary boundary( K, dshape, SurfelAdjacency<Z3i::KSpace::dimension>( true ), bel );
+  MyDigitalSurface surf( boundary );
+  VisitorRange range( new Visitor( surf, *surf.begin() ) );
+  const std::vector<Z3i::SCell> surfels( range.begin(), range.end() );
+
+  // The largest kernel goes beyond the domain.
+  const std::vector<double> radii = { 1.0, 3.0, 5.0 };
+
+  SECTION( "Mean curvatures are the ones of IntegralInvariantVolumeEstimator" )
+    {
+      for ( double re : radii )
+        {
+          typedef functors::IIMeanCurvature3DFunctor<Z3i::Space> Functor;
+          Functor functor;
+          functor.init( h, re );
+
+          IntegralInvariantVolumeEstimator<Z3i::KSpace, DigitalShape, Functor> convolver( functor );
+          convolver.attach( K, dshape );
+          convolver.setParams( re / h );
+          convolver.init( h, surfels.begin(), surfels.end() );
+          std::vector<double> expected;
+          convolver.eval( surfels.begin(), surfels.end(), std::back_inserter( expected ) );
+
+          IntegralInvariantFFTEstimator<Z3i::KSpace, DigitalShape, Functor> fft( K, dshape, functor );
+          fft.setParams( re / h );
+          fft.init( h, surfels.begin(), surfels.end() );
+          REQUIRE( fft.isValid() );
+          std::vector<double> results;
+          fft.eval( surfels.begin(), surfels.end(), std::back_inserter( results ) );
+
+          REQUIRE( results == expected );
+        }
+    }
+
+  SECTION( "Gaussian curvatures match IntegralInvariantCovarianceEstimator" )
+    {
+      for ( double re : radii )
+        {
+          typedef functors::IIGaussianCurvature3DFunctor<Z3i::Space> Functor;
+          Functor functor;
+          functor.init( h, re );
+
+          IntegralInvariantCovarianceEstimator<Z3i::KSpace, DigitalShape, Functor> convolver( functor );
+          convolver.attach( K, dshape );
+          convolver.setParams( re / h );
+          convolver.init( h, surfels.begin(), surfels.end() );
+          std::vector<double> expected;
+          convolver.eval( surfels.begin(), surfels.end(), std::back_inserter( expected ) );
+
+          IntegralInvariantFFTEstimator<Z3i::KSpace, DigitalShape, Functor> fft( K, dshape, functor );
+          fft.setParams( re / h );
+          fft.init( h, surfels.begin(), surfels.end() );
+          std::vector<double> results;
+          fft.eval( surfels.begin(), surfels.end(), std::back_inserter( results ) );
+
+          REQUIRE( results.size() == expected.size() );
+          for ( std::size_t i = 0; i < results.size(); ++i )
+            REQUIRE( results[ i ] == Approx( expected[ i ] ).margin( 1e-8 ) );
+        }
+    }
+}
+
+TEST_CASE( "Testing IntegralInvariantFFTEstimator crossover" )
+{
+  typedef functors::IIMeanCurvature3DFunctor<Z3i::Space> Functor;
+  typedef IntegralInvariantFFTEstimator<Z3i::KSpace, DigitalShape, Functor> FFTEstimator;
+
+  Z3i::KSpace K;
+  REQUIRE( K.init( Z3i::Point::diagonal( 0 ), Z3i::Point::diagonal( 127 ), true ) );
+
+  // Few surfels and a small kernel: per-surfel convolutions.
+  REQUIRE( ! FFTEstimator::isFasterThanConvolver( K, 100, 3.0 ) );
+  // Most of a large surface and a large kernel: FFT.
+  REQUIRE( FFTEstimator::isFasterThanConvolver( K, 100000, 20.0 ) );
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
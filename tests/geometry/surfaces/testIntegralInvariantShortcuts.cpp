@@ -84,6 +84,25 @@ TEST_CASE( "Testing IntegralInvariant Shortcuts API" )
     for(std::size_t i = 0; i < G.size(); ++i)
      REQUIRE( Kcurv[i] == Approx( G[i] ) );
   }
+
+  SECTION("Testing that the II mean curvature backends give the same values")
+  {
+    auto Hcurv    = SHG3::getIIMeanCurvatures( binary_image, surfels, params );
+    auto HcurvSAT = SHG3::getIIMeanCurvatures( binary_image, surfels,
+                                               params( "II-backend", "SAT" ) );
+    REQUIRE( Hcurv.size() == surfels.size() );
+    REQUIRE( Hcurv == HcurvSAT );
+  }
+
+  SECTION("Testing that the FFT backend gives the same Gaussian curvatures")
+  {
+    // Without FFTW3, the convolver is used.
+    auto KcurvFFT = SHG3::getIIGaussianCurvatures( binary_image, surfels,
+                                                   params( "II-backend", "FFT" ) );
+    REQUIRE( KcurvFFT.size() == Kcurv.size() );
+    for(std::size_t i = 0; i < Kcurv.size(); ++i)
+      REQUIRE( KcurvFFT[i] == Approx( Kcurv[i] ).margin( 1e-8 ) );
+  }
 }
 
 /** @ingroup Tests **/
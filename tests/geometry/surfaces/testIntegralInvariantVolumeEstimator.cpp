@@ -30,6 +30,7 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 #include <iostream>
+#include <list>
 #include "DGtal/base/Common.h"
 
 /// Shape
@@ -45,6 +46,7 @@
 /// Estimator
 #include "DGtal/geometry/surfaces/estimation/IIGeometricFunctors.h"
 #include "DGtal/geometry/surfaces/estimation/IntegralInvariantVolumeEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantSATVolumeEstimator.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -261,13 +263,135 @@ bool testMeanCurvature3d( double h, double delta )
   return true;
 }
 
+bool testRangeEval3d( double h )
+{
+  typedef ImplicitBall<Z3i::Space> ImplicitShape;
+  typedef GaussDigitizer<Z3i::Space, ImplicitShape> DigitalShape;
+  typedef LightImplicitDigitalSurface<Z3i::KSpace,DigitalShape> Boundary;
+  typedef DigitalSurface< Boundary > MyDigitalSurface;
+  typedef DepthFirstVisitor< MyDigitalSurface > Visitor;
+  typedef GraphVisitorRange< Visitor > VisitorRange;
+
+  typedef functors::IIMeanCurvature3DFunctor<Z3i::Space> MyIICurvatureFunctor;
+  typedef IntegralInvariantVolumeEstimator< Z3i::KSpace, DigitalShape, MyIICurvatureFunctor > MyIICurvatureEstimator;
+  typedef MyIICurvatureFunctor::Value Value;
+
+  double re = 3;
+
+  trace.beginBlock( "Range evaluation (random access vs forward iterators) ..." );
+
+  ImplicitShape ishape( Z3i::RealPoint( 0, 0, 0 ), 5 );
+  DigitalShape dshape;
+  dshape.attach( ishape );
+  dshape.init( Z3i::RealPoint( -10.0, -10.0, -10.0 ), Z3i::RealPoint( 10.0, 10.0, 10.0 ), h );
+
+  Z3i::KSpace K;
+  if ( !K.init( dshape.getLowerBound(), dshape.getUpperBound(), true ) )
+  {
+    trace.error() << "Problem with Khalimsky space" << std::endl;
+    return false;
+  }
+
+  Z3i::KSpace::Surfel bel = Surfaces<Z3i::KSpace>::findABel( K, dshape, 10000 );
+  Boundary boundary( K, dshape, SurfelAdjacency<Z3i::KSpace::dimension>( true ), bel );
+  MyDigitalSurface surf ( boundary );
+
+  VisitorRange range( new Visitor( surf, *surf.begin() ));
+  std::vector< Z3i::KSpace::Surfel > surfels( range.begin(), range.end() );
+  std::list< Z3i::KSpace::Surfel > surfelList( surfels.begin(), surfels.end() );
+
+  MyIICurvatureFunctor curvatureFunctor;
+  curvatureFunctor.init( h, re );
+
+  MyIICurvatureEstimator curvatureEstimator( curvatureFunctor );
+  curvatureEstimator.attach( K, dshape );
+  curvatureEstimator.setParams( re/h );
+  curvatureEstimator.init( h, surfels.begin(), surfels.end() );
+
+  // Random access ranges may be evaluated by chunks (with OpenMP).
+  std::vector< Value > results;
+  curvatureEstimator.eval( surfels.begin(), surfels.end(), std::back_inserter( results ) );
+  std::vector< Value > expected;
+  curvatureEstimator.eval( surfelList.begin(), surfelList.end(), std::back_inserter( expected ) );
+
+  trace.info() << "Nb surfels: " << surfels.size() << std::endl;
+  const bool ok = ( results.size() == surfels.size() ) && ( results == expected );
+  trace.endBlock();
+  return ok;
+}
+
+bool testSATBackend3d( double h )
+{
+  typedef ImplicitBall<Z3i::Space> ImplicitShape;
+  typedef GaussDigitizer<Z3i::Space, ImplicitShape> DigitalShape;
+  typedef LightImplicitDigitalSurface<Z3i::KSpace,DigitalShape> Boundary;
+  typedef DigitalSurface< Boundary > MyDigitalSurface;
+  typedef DepthFirstVisitor< MyDigitalSurface > Visitor;
+  typedef GraphVisitorRange< Visitor > VisitorRange;
+
+  typedef functors::IIMeanCurvature3DFunctor<Z3i::Space> MyIICurvatureFunctor;
+  typedef IntegralInvariantVolumeEstimator< Z3i::KSpace, DigitalShape, MyIICurvatureFunctor > MyIICurvatureEstimator;
+  typedef IntegralInvariantSATVolumeEstimator< Z3i::KSpace, DigitalShape, MyIICurvatureFunctor > MyIISATCurvatureEstimator;
+  typedef MyIICurvatureFunctor::Value Value;
+
+  trace.beginBlock( "Summed volume table backend vs convolver ..." );
+
+  ImplicitShape ishape( Z3i::RealPoint( 0, 0, 0 ), 5 );
+  DigitalShape dshape;
+  dshape.attach( ishape );
+  dshape.init( Z3i::RealPoint( -10.0, -10.0, -10.0 ), Z3i::RealPoint( 10.0, 10.0, 10.0 ), h );
+
+  Z3i::KSpace K;
+  if ( !K.init( dshape.getLowerBound(), dshape.getUpperBound(), true ) )
+  {
+    trace.error() << "Problem with Khalimsky space" << std::endl;
+    return false;
+  }
+
+  Z3i::KSpace::Surfel bel = Surfaces<Z3i::KSpace>::findABel( K, dshape, 10000 );
+  Boundary boundary( K, dshape, SurfelAdjacency<Z3i::KSpace::dimension>( true ), bel );
+  MyDigitalSurface surf ( boundary );
+
+  VisitorRange range( new Visitor( surf, *surf.begin() ));
+  std::vector< Z3i::KSpace::Surfel > surfels( range.begin(), range.end() );
+
+  bool ok = true;
+  // The largest kernel goes beyond the domain.
+  for ( double re : { 1.0, 3.0, 6.0 } )
+    {
+      MyIICurvatureFunctor curvatureFunctor;
+      curvatureFunctor.init( h, re );
+
+      MyIICurvatureEstimator curvatureEstimator( curvatureFunctor );
+      curvatureEstimator.attach( K, dshape );
+      curvatureEstimator.setParams( re/h );
+      curvatureEstimator.init( h, surfels.begin(), surfels.end() );
+      std::vector< Value > expected;
+      curvatureEstimator.eval( surfels.begin(), surfels.end(), std::back_inserter( expected ) );
+
+      MyIISATCurvatureEstimator satEstimator( K, dshape, curvatureFunctor );
+      satEstimator.setParams( re/h );
+      satEstimator.init( h, surfels.begin(), surfels.end() );
+      std::vector< Value > results;
+      satEstimator.eval( surfels.begin(), surfels.end(), std::back_inserter( results ) );
+
+      trace.info() << satEstimator << std::endl;
+      ok = ok && satEstimator.isValid() && ( results == expected )
+        && ( satEstimator.eval( surfels.begin() ) == expected.front() );
+    }
+
+  trace.endBlock();
+  return ok;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Standard services - public :
 
 int main( int /*argc*/, char** /*argv*/ )
 {
   trace.beginBlock ( "Testing class IntegralInvariantVolumeEstimator and 2d/3d mean curvature functors" );
-    bool res = testCurvature2d( 0.05, 0.002 ) && testMeanCurvature3d( 0.6, 0.008 );
+    bool res = testCurvature2d( 0.05, 0.002 ) && testMeanCurvature3d( 0.6, 0.008 )
+      && testRangeEval3d( 0.5 ) && testSATBackend3d( 0.5 );
     trace.emphase() << ( res ? "Passed." : "Error." ) << std::endl;
   trace.endBlock();
   return res ? 0 : 1;
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include "DGtal/base/Common.h"
 #include "DGtal/kernel/SpaceND.h"
+#include "DGtal/kernel/domains/HyperRectDomain.h"
 #include "DGtal/geometry/tools/QuickHull.h"
 #include "DGtalCatch.h"
 ///////////////////////////////////////////////////////////////////////////////
@@ -188,6 +189,67 @@ SCENARIO( "QuickHull< ConvexHullIntegralKernel< 3 > > unit tests", "[quickhull][
 }
 
 
+SCENARIO( "QuickHull< ConvexHullIntegralKernel< 3 > > streaming and filtering tests", "[quickhull][integral_kernel][3d]" )
+{
+  typedef ConvexHullIntegralKernel< 3 >    QHKernel;
+  typedef QuickHull< QHKernel >            QHull;
+  typedef SpaceND< 3, int >                Space;
+  typedef Space::Point                     Point;
+  typedef HyperRectDomain< Space >         Domain;
+
+  GIVEN( "Given the lattice points of a box streamed from a domain" ) {
+    const Domain domain( Point( -10, -7, 0 ), Point( 10, 12, 15 ) );
+    QHull hull;
+    hull.setInput( domain.begin(), domain.end(), false );
+    const auto nb = hull.nbPoints();
+    const auto nb_removed = hull.filterInput();
+    hull.computeConvexHull();
+    THEN( "No point is copied and only boundary points are kept by the filter" ) {
+      REQUIRE( nb == domain.size() );
+      REQUIRE( nb_removed == 19 * 18 * 14 );
+      REQUIRE( hull.nbPoints() + nb_removed == nb );
+    }
+    THEN( "The convex hull is valid and is the box" ) {
+      REQUIRE( hull.check() );
+      REQUIRE( hull.nbVertices() == 8 );
+      REQUIRE( hull.nbFacets() == 6 );
+    }
+  }
+  GIVEN( "Given 2000 random points with duplicates in a ball of radius 20" ) {
+    std::vector<Point> V = randomPointsInBall< Point >( 2000, 20 );
+    QHull ref_hull;
+    ref_hull.setInput( V, true );
+    ref_hull.computeConvexHull();
+    QHull hull;
+    hull.setInput( V.cbegin(), V.cend(), true );
+    const auto nb_removed = hull.filterInput();
+    hull.computeConvexHull();
+    THEN( "The filtered convex hull is valid and is the same as the unfiltered one" ) {
+      REQUIRE( nb_removed > 0 );
+      REQUIRE( hull.check() );
+      REQUIRE( hull.nbVertices() == ref_hull.nbVertices() );
+      REQUIRE( hull.nbFacets()   == ref_hull.nbFacets() );
+      std::vector< Point > positions, ref_positions;
+      hull.getVertexPositions( positions );
+      ref_hull.getVertexPositions( ref_positions );
+      REQUIRE( positions == ref_positions );
+    }
+    THEN( "The mappings between input and remaining points are consistent" ) {
+      REQUIRE( hull.input2comp.size() == V.size() );
+      REQUIRE( hull.comp2input.size() == hull.nbPoints() );
+      std::size_t nb_errors = 0;
+      for ( std::size_t i = 0; i < V.size(); i++ ) {
+        const auto c = hull.input2comp[ i ];
+        if ( c == QHull::UNASSIGNED ) continue;
+        nb_errors += ( hull.points[ c ] == V[ i ]
+                       && V[ hull.comp2input[ c ] ] == V[ i ] ) ? 0 : 1;
+      }
+      REQUIRE( nb_errors == 0 );
+    }
+  }
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Functions for testing class QuickHull in 4D.
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testDenseFMM.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class DenseFMM.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/kernel/domains/DomainPredicate.h"
+#include "DGtal/kernel/sets/DigitalSetFromMap.h"
+#include "DGtal/images/ImageContainerBySTLMap.h"
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/geometry/volumes/distance/FMM.h"
+#include "DGtal/geometry/volumes/distance/DenseFMM.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class DenseFMM.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+  /// The domain, except a wall along the second axis with a hole.
+  struct WallPredicate
+  {
+    typedef Z3i::Point Point;
+    Z3i::Domain domain;
+    bool operator()( const Point& p ) const
+    {
+      return domain.isInside( p ) && ( p[ 0 ] != 2 || p[ 1 ] > 6 );
+    }
+  };
+
+  /// Pairs of (inner, outer) adjacent points of a digital ball.
+  std::vector< std::pair<Z3i::Point, Z3i::Point> >
+  ballInterface( const Z3i::Domain& domain, double radius )
+  {
+    std::vector< std::pair<Z3i::Point, Z3i::Point> > pairs;
+    for ( auto p : domain )
+      if ( p.squaredNorm() <= radius * radius )
+        for ( Dimension k = 0; k < 3; ++k )
+          for ( int step = -1; step <= 1; step += 2 )
+            {
+              Z3i::Point q = p;
+              q[ k ] += step;
+              if ( q.squaredNorm() > radius * radius )
+                pairs.push_back( std::make_pair( p, q ) );
+            }
+    return pairs;
+  }
+}
+
+TEST_CASE( "Testing DenseFMM" )
+{
+  const Z3i::Domain domain( Z3i::Point( -12, -10, -9 ), Z3i::Point( 12, 11, 10 ) );
+  typedef functors::DomainPredicate<Z3i::Domain> Predicate;
+  const Predicate dp( domain );
+  typedef ImageContainerBySTLMap<Z3i::Domain, double> MapImage;
+  typedef DigitalSetFromMap<MapImage> MapSet;
+  typedef ImageContainerBySTLVector<Z3i::Domain, double> Image;
+  const auto pairs = ballInterface( domain, 5.5 );
+
+  SECTION( "Signed distances are the same as with FMM" )
+    {
+      MapImage map( domain );
+      MapSet set( map );
+      typedef FMM<MapImage, MapSet, Predicate> RefFMM;
+      RefFMM::initFromIncidentPointsRange( pairs.begin(), pairs.end(), map, set, 0.5 );
+      RefFMM ref_fmm( map, set, dp );
+      ref_fmm.compute();
+
+      Image image( domain );
+      std::fill( image.begin(), image.end(), 1000.0 );
+      DenseFMM<Image, Predicate> fmm( image, dp );
+      fmm.initFromIncidentPointsRange( pairs.begin(), pairs.end(), 0.5 );
+      fmm.compute();
+      REQUIRE( fmm.isValid() );
+      REQUIRE( fmm.nbAccepted() == domain.size() );
+      REQUIRE( fmm.nbAccepted() == set.size() );
+      REQUIRE( fmm.min() == ref_fmm.min() );
+      REQUIRE( fmm.max() == ref_fmm.max() );
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        nb_errors += ( fmm.isAccepted( p ) && image( p ) == map( p ) ) ? 0 : 1;
+      REQUIRE( nb_errors == 0 );
+      Z3i::Point p;
+      double d;
+      REQUIRE( ! fmm.computeOneStep( p, d ) );
+    }
+
+  SECTION( "Thresholds stop the propagation as with FMM" )
+    {
+      MapImage map( domain );
+      MapSet set( map );
+      typedef FMM<MapImage, MapSet, Predicate> RefFMM;
+      RefFMM::initFromIncidentPointsRange( pairs.begin(), pairs.end(), map, set, 0.5 );
+      RefFMM ref_fmm( map, set, dp, 100000, 3.0 );
+      ref_fmm.compute();
+
+      Image image( domain );
+      std::fill( image.begin(), image.end(), 1000.0 );
+      DenseFMM<Image, Predicate> fmm( image, dp, 100000, 3.0 );
+      fmm.initFromIncidentPointsRange( pairs.begin(), pairs.end(), 0.5 );
+      fmm.compute();
+      REQUIRE( fmm.isValid() );
+      REQUIRE( fmm.nbAccepted() == set.size() );
+      REQUIRE( fmm.max() < 3.0 );
+      unsigned int nb_errors = 0;
+      for ( auto p : set )
+        nb_errors += ( fmm.isAccepted( p ) && image( p ) == map( p ) ) ? 0 : 1;
+      REQUIRE( nb_errors == 0 );
+      REQUIRE( image( domain.upperBound() ) == 1000.0 );
+      REQUIRE( fmm.state( domain.upperBound() ) == DenseFMM<Image, Predicate>::Far );
+
+      // Area threshold, step by step.
+      std::set<Z3i::Point> seeds;
+      for ( auto pair : pairs ) { seeds.insert( pair.first ); seeds.insert( pair.second ); }
+      Image image2( domain );
+      std::fill( image2.begin(), image2.end(), 1000.0 );
+      DenseFMM<Image, Predicate> fmm2( image2, dp, seeds.size() + 50, 1000.0 );
+      fmm2.initFromIncidentPointsRange( pairs.begin(), pairs.end(), 0.5 );
+      Z3i::Point p;
+      double d, last = 0.0;
+      bool increasing = true;
+      while ( fmm2.computeOneStep( p, d ) )
+        {
+          increasing = increasing && ( std::abs( d ) >= last );
+          last = std::abs( d );
+        }
+      REQUIRE( increasing );
+      REQUIRE( fmm2.nbAccepted() == seeds.size() + 49 );
+    }
+
+  SECTION( "Fast sweeping gives the same distances as marching" )
+    {
+      const Z3i::Point source( -8, -3, 2 );
+      WallPredicate wall;
+      wall.domain = domain;
+
+      Image marched( domain );
+      std::fill( marched.begin(), marched.end(), -1.0 );
+      DenseFMM<Image, WallPredicate> fmm( marched, wall );
+      fmm.insertAccepted( source, 0.0 );
+      fmm.insertAccepted( Z3i::Point( 10, 10, -8 ), 0.0 );
+      fmm.compute();
+
+      for ( unsigned int blockSize : { 4, 7, 64 } )
+        {
+          Image swept( domain );
+          std::fill( swept.begin(), swept.end(), -1.0 );
+          DenseFMM<Image, WallPredicate> sweeping( swept, wall );
+          sweeping.insertAccepted( source, 0.0 );
+          sweeping.insertAccepted( Z3i::Point( 10, 10, -8 ), 0.0 );
+          sweeping.computeBySweeping( blockSize );
+          REQUIRE( sweeping.nbAccepted() == fmm.nbAccepted() );
+          REQUIRE( std::abs( sweeping.max() - fmm.max() ) < 1e-9 );
+          unsigned int nb_errors = 0;
+          for ( auto p : domain )
+            nb_errors += ( sweeping.isAccepted( p ) == fmm.isAccepted( p )
+                           && std::abs( swept( p ) - marched( p ) ) < 1e-9 ) ? 0 : 1;
+          REQUIRE( nb_errors == 0 );
+        }
+      // The wall has no distance, and the hole makes the distance
+      // behind the wall greater than the Euclidean distance.
+      REQUIRE( fmm.state( Z3i::Point( 2, 0, 0 ) ) == DenseFMM<Image, WallPredicate>::Outside );
+      REQUIRE( marched( Z3i::Point( 2, 0, 0 ) ) == -1.0 );
+      REQUIRE( marched( Z3i::Point( 4, -3, 2 ) ) > 12.5 );
+    }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
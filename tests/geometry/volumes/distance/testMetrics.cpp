@@ -370,6 +370,79 @@ bool testBinarySearch()
 }
 
 
+template <DGtal::uint32_t p>
+bool testLineKernels()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Testing 1D span kernels of l_p metrics..." );
+  typedef ExactPredicateLpSeparableMetric<Z3i::Space, p> Metric;
+  typedef typename Metric::RawValue RawValue;
+  typedef typename Metric::Abscissa Abscissa;
+  Metric metric;
+  trace.info() << metric << std::endl;
+
+  srand( 0 );
+  const Z3i::Point starting( 0, 3, -2 ), endpoint( 20, 3, -2 );
+  for ( unsigned int i = 0; i < 1000; ++i )
+    {
+      const Z3i::Point u( rand() % 7, rand() % 21 - 10, rand() % 21 - 10 );
+      const Z3i::Point v( u[0] + 1 + rand() % 7, rand() % 21 - 10, rand() % 21 - 10 );
+      const Z3i::Point w( v[0] + 1 + rand() % 7, rand() % 21 - 10, rand() % 21 - 10 );
+      const Z3i::Point x( rand() % 21, 3, -2 );
+
+      const RawValue nu = metric.partialRawDistance( u, starting, 0 );
+      const RawValue nv = metric.partialRawDistance( v, starting, 0 );
+      const RawValue nw = metric.partialRawDistance( w, starting, 0 );
+
+      // Partial and full raw distances
+      nbok += ( nu + metric.rawDistance( Z3i::Point( u[0], 0, 0 ), Z3i::Point( x[0], 0, 0 ) )
+                == metric.rawDistance( u, x ) ) ? 1 : 0;
+      nb++;
+
+      // Line and point versions of the predicates
+      nbok += ( metric.closest( x[0], u[0], nu, v[0], nv ) == metric.closest( x, u, v ) ) ? 1 : 0;
+      nb++;
+      nbok += ( metric.hiddenBy( u[0], nu, v[0], nv, w[0], nw, starting[0], endpoint[0] )
+                == metric.hiddenBy( u, v, w, starting, endpoint, 0 ) ) ? 1 : 0;
+      nb++;
+
+      // Voronoi abscissa against an exhaustive search (no binary
+      // search for l_2)
+      if constexpr ( p != 2 )
+        if ( metric.rawDistance( starting, u ) < metric.rawDistance( starting, v ) )
+          {
+            Abscissa last = starting[0];
+            for ( Z3i::Point y = starting; y[0] <= endpoint[0]; ++y[0] )
+              if ( metric.rawDistance( y, u ) < metric.rawDistance( y, v ) )
+                last = y[0];
+            nbok += ( metric.binarySearchHidden( u[0], v[0], nu, nv, starting[0], endpoint[0] ) == last ) ? 1 : 0;
+            nb++;
+          }
+
+      // Batched closest kernel (l_2 only) against the line closest
+      if constexpr ( p == 2 )
+        {
+          const Abscissa abscissas[ 3 ] = { u[0], v[0], w[0] };
+          const RawValue norms[ 3 ]     = { nu, nv, nw };
+          RawValue switches[ 2 ];
+          metric.closestSwitches( abscissas, norms, 3, switches );
+          bool ok = true;
+          for ( Abscissa y = -40; y <= 60; ++y )
+            for ( unsigned int k = 0; k < 2; ++k )
+              ok = ok && ( ( metric.closest( y, abscissas[k], norms[k], abscissas[k+1], norms[k+1] )
+                             == ClosestFIRST ) == ( y < switches[k] ) );
+          nbok += ok ? 1 : 0;
+          nb++;
+        }
+    }
+  trace.info() << "(" << nbok << "/" << nb << ") " << std::endl;
+
+  trace.endBlock();
+  return nbok == nb;
+}
+
 bool testSpecialCasesLp()
 {
   unsigned int nbok = 0;
@@ -494,6 +567,9 @@ int main( int argc, char** argv )
     && testBinarySearch()
     && testSpecialCasesL2()
     && testSpecialCasesLp()
+    && testLineKernels<1>()
+    && testLineKernels<2>()
+    && testLineKernels<3>()
     && testConcepts();
   trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
   trace.endBlock();
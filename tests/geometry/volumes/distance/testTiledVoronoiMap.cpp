@@ -0,0 +1,135 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testTiledVoronoiMap.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class TiledVoronoiMap.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include "DGtal/base/Common.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtalCatch.h"
+
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/images/ImageFactoryFromImage.h"
+#include "DGtal/images/ImageCache.h"
+#include "DGtal/images/TiledImage.h"
+#include "DGtal/geometry/volumes/distance/DistanceTransformation.h"
+#include "DGtal/geometry/volumes/distance/TiledVoronoiMap.h"
+///////////////////////////////////////////////////////////////////////////////
+using namespace DGtal;
+
+typedef ImageContainerBySTLVector<Z3i::Domain, DGtal::int64_t> LabelImage;
+typedef ImageFactoryFromImage<LabelImage> LabelFactory;
+typedef ImageContainerBySTLVector<Z3i::Domain, double> DistanceImage;
+typedef ImageFactoryFromImage<DistanceImage> DistanceFactory;
+typedef TiledVoronoiMap<LabelFactory, Z3i::DigitalSet, Z3i::L2Metric> TiledVMap;
+typedef DistanceTransformation<Z3i::Space, Z3i::DigitalSet, Z3i::L2Metric> DT;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class TiledVoronoiMap.
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE( "Testing TiledVoronoiMap" )
+{
+  // Domain extent not divisible by the number of tiles.
+  Z3i::Domain domain( Z3i::Point( -3, 0, 2 ), Z3i::Point( 20, 16, 24 ) );
+  Z3i::DigitalSet set( domain );
+  for ( auto const & p : domain )
+    set.insertNew( p );
+  srand( 0 );
+  for ( int i = 0; i < 30; ++i )
+    set.erase( Z3i::Point( -3 + rand() % 24, rand() % 17, 2 + rand() % 23 ) );
+
+  DT dt( domain, set, Z3i::l2Metric );
+
+  LabelImage labels( domain );
+  LabelFactory factory( labels );
+
+  SECTION( "Voronoi sites and distances match DistanceTransformation" )
+    {
+      for ( auto budget : { 1000000u, 1000u, 10u } )
+        {
+          TiledVMap tvm( factory, set, Z3i::l2Metric, 5, budget );
+          REQUIRE( tvm.isValid() );
+
+          unsigned int nbOk = 0;
+          for ( auto const & p : domain )
+            {
+              const auto l = labels( p );
+              if ( l != TiledVMap::noSite()
+                   && Z3i::l2Metric( p, tvm.site( l ) ) == dt( p )
+                   && set( tvm.site( l ) ) == false )
+                nbOk++;
+            }
+          REQUIRE( nbOk == domain.size() );
+        }
+    }
+
+  SECTION( "Distance transformation written through a factory" )
+    {
+      TiledVMap tvm( factory, set, Z3i::l2Metric, 4, 500 );
+      DistanceImage distances( domain );
+      DistanceFactory distanceFactory( distances );
+      tvm.computeDistanceTransformation( distanceFactory );
+
+      unsigned int nbOk = 0;
+      for ( auto const & p : domain )
+        if ( distances( p ) == dt( p ) )
+          nbOk++;
+      REQUIRE( nbOk == domain.size() );
+    }
+
+  SECTION( "Reading the map through a TiledImage" )
+    {
+      TiledVMap tvm( factory, set, Z3i::l2Metric, 4, 500 );
+
+      typedef ImageCacheReadPolicyFIFO<LabelImage, LabelFactory> ReadPolicy;
+      typedef ImageCacheWritePolicyWB<LabelImage, LabelFactory> WritePolicy;
+      ReadPolicy readPolicy( factory, 4 );
+      WritePolicy writePolicy( factory );
+      TiledImage<LabelImage, LabelFactory, ReadPolicy, WritePolicy> tiled( factory, readPolicy, writePolicy, 4 );
+
+      unsigned int nbOk = 0;
+      for ( auto const & p : domain )
+        if ( Z3i::l2Metric( p, tvm.site( tiled( p ) ) ) == dt( p ) )
+          nbOk++;
+      REQUIRE( nbOk == domain.size() );
+    }
+}
+
+TEST_CASE( "Testing TiledVoronoiMap without site" )
+{
+  Z3i::Domain domain( Z3i::Point( 0, 0, 0 ), Z3i::Point( 9, 9, 9 ) );
+  Z3i::DigitalSet set( domain );
+  for ( auto const & p : domain )
+    set.insertNew( p );
+
+  LabelImage labels( domain );
+  LabelFactory factory( labels );
+  TiledVMap tvm( factory, set, Z3i::l2Metric, 3, 100 );
+
+  REQUIRE( std::all_of( labels.begin(), labels.end(),
+                        []( DGtal::int64_t l ) { return l == TiledVMap::noSite(); } ) );
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
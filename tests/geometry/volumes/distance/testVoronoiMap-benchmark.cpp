@@ -0,0 +1,98 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testVoronoiMap-benchmark.cpp
+ * @ingroup Tests
+ *
+ * Scaling benchmark of VoronoiMap / DistanceTransformation with
+ * respect to the number of threads (from 1 to the number of available
+ * cores when DGtal is built with OpenMP).
+ *
+ * Usage: testVoronoiMap-benchmark [size [nbSeeds]]
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include "DGtal/base/Common.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/images/SimpleThresholdForegroundPredicate.h"
+#include "DGtal/geometry/volumes/distance/ExactPredicateLpSeparableMetric.h"
+#include "DGtal/geometry/volumes/distance/DistanceTransformation.h"
+#include "DGtalBenchmarkThreads.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for benchmarking class VoronoiMap.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef ImageContainerBySTLVector<Z3i::Domain, unsigned char> Image;
+typedef functors::SimpleThresholdForegroundPredicate<Image> Predicate;
+typedef DistanceTransformation<Z3i::Space, Predicate, Z3i::L2Metric> DT;
+
+/**
+ * Runs the L2 distance transformation of a random seed image.
+ *
+ * @param image the input image (seeds are the zero valued points).
+ * @return the elapsed time in milliseconds.
+ */
+double runDT( const Image & image )
+{
+  Predicate predicate( image, 0 );
+  trace.beginBlock( "DistanceTransformation" );
+  DT dt( image.domain(), predicate, Z3i::l2Metric );
+  trace.info() << "Max distance = " << *std::max_element( dt.constRange().begin(),
+                                                          dt.constRange().end() )
+               << std::endl;
+  return trace.endBlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Benchmarking VoronoiMap thread scaling" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  const int size    = argc > 1 ? atoi( argv[ 1 ] ) : 256;
+  const int nbSeeds = argc > 2 ? atoi( argv[ 2 ] ) : 1000;
+
+  Z3i::Domain domain( Z3i::Point::diagonal( 0 ), Z3i::Point::diagonal( size - 1 ) );
+  Image image( domain );
+  std::fill( image.begin(), image.end(), 1 );
+  srand( 0 );
+  for ( int i = 0; i < nbSeeds; ++i )
+    image.setValue( Z3i::Point( rand() % size, rand() % size, rand() % size ), 0 );
+
+  benchmarkThreadScaling( [&image] { return runDT( image ); } );
+
+  trace.endBlock();
+  return 0;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
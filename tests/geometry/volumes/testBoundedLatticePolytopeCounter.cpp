@@ -123,3 +123,70 @@ SCENARIO( "BoundedLatticePolytope< Z3 > unit tests", "[lattice_polytope][3d]" )
       }
   }
 }
+
+SCENARIO( "BoundedLatticePolytopeCounter< Z3 > visitors and big polytopes", "[lattice_polytope][3d]" )
+{
+  typedef SpaceND<3,int>                   Space;
+  typedef Space::Point                     Point;
+  typedef BoundedLatticePolytope< Space >  Polytope;
+  typedef BoundedLatticePolytopeCounter< Space > Counter;
+  typedef Counter::Interval                Interval;
+
+  GIVEN( "A big simplex P at (0,0,0), (70,20,5), (10,75,-30), (-5,10,40)" ) {
+    Point a( 0, 0, 0 );
+    Point b( 70, 20, 5 );
+    Point c( 10, 75, -30 );
+    Point d( -5, 10, 40 );
+    Polytope P { a, b, c, d };
+    Counter C( P );
+    int nbInside   = 0;
+    int nbInterior = 0;
+    for ( auto&& p : P.getDomain() )
+      {
+        nbInside   += P.isInside( p )         ? 1 : 0;
+        nbInterior += P.isInterior( p )       ? 1 : 0;
+      }
+    THEN( "Counting rows, possibly in parallel, gives the number of points" )
+      {
+        REQUIRE( C.countAlongAxis( 0 ) == nbInside );
+        REQUIRE( C.countAlongAxis( 2 ) == nbInside );
+        REQUIRE( C.countInteriorAlongAxis( 1 ) == nbInterior );
+        REQUIRE( C.countInteriorAlongAxis( 2 ) == nbInterior );
+      }
+    THEN( "Visitors give the same rows as intervals along axis" )
+      {
+        int nb_rows = 0;
+        int nb      = 0;
+        int nb_wrong_rows = 0;
+        C.visitAlongAxis( [&] ( const Point& p, const Interval& I )
+        {
+          nb_rows += 1;
+          nb      += I.second - I.first;
+          nb_wrong_rows += ( p[ 1 ] == C.lowerBound()[ 1 ]
+                             && I == C.intersectionIntervalAlongAxis( p, 1 ) ) ? 0 : 1;
+        }, 1 );
+        const Point e = C.upperBound() - C.lowerBound() + Point::diagonal( 1 );
+        REQUIRE( e[ 0 ] * e[ 2 ] >= 4096 ); // rows are counted in parallel
+        REQUIRE( nb_rows > 0 );
+        REQUIRE( nb_rows < e[ 0 ] * e[ 2 ] );
+        REQUIRE( nb == nbInside );
+        REQUIRE( nb_wrong_rows == 0 );
+        int nb_int = 0;
+        C.visitInteriorAlongAxis( [&] ( const Point&, const Interval& I )
+        { nb_int += I.second - I.first; }, 0 );
+        REQUIRE( nb_int == nbInterior );
+      }
+    THEN( "Enumerated points are inside the polytope" )
+      {
+        std::vector< Point > pts, int_pts;
+        C.getPointsAlongAxis( pts, 2 );
+        C.getInteriorPointsAlongAxis( int_pts, 2 );
+        int nb_outside = 0;
+        for ( auto&& p : pts )     nb_outside += P.isInside  ( p ) ? 0 : 1;
+        for ( auto&& p : int_pts ) nb_outside += P.isInterior( p ) ? 0 : 1;
+        REQUIRE( (int) pts.size()     == nbInside );
+        REQUIRE( (int) int_pts.size() == nbInterior );
+        REQUIRE( nb_outside == 0 );
+      }
+  }
+}
@@ -1024,3 +1024,84 @@ SCENARIO( "DigitalConvexity< Z3 > full subconvexity of points and triangles", "[
   }
   
 }
+
+SCENARIO( "DigitalConvexity< Z3 > batched and parallel full convexity", "[full_convexity][3d]" )
+{
+  typedef KhalimskySpaceND<3,int>          KSpace;
+  typedef KSpace::Point                    Point;
+  typedef DigitalConvexity< KSpace >       DConvexity;
+  typedef std::vector< Point >             PointRange;
+
+  DConvexity dconv( Point( -50, -50, -50 ), Point( 50, 50, 50 ) );
+  std::vector< PointRange > XX;
+  for ( unsigned int i = 0; i < 40; ++i )
+    {
+      PointRange X( 20 );
+      for ( auto& p : X ) p = Point( rand() % 6, rand() % 6, rand() % 6 );
+      auto P = dconv.makePolytope( X );
+      PointRange Y;
+      P.getPoints( Y );
+      // Half of the sets are made non convex by removing a point.
+      if ( i % 2 == 1 && Y.size() > 2 ) Y.erase( Y.begin() + Y.size() / 2 );
+      XX.push_back( Y );
+    }
+  WHEN( "Checking many small sets at once" ) {
+    const auto results = dconv.areFullyConvex( XX );
+    DConvexity::Scratch scratch;
+    unsigned int nb_ok = 0;
+    unsigned int nb_fcvx = 0;
+    for ( std::size_t i = 0; i < XX.size(); ++i )
+      {
+        const bool fcvx = dconv.isFullyConvex( XX[ i ], false );
+        nb_ok   += ( results[ i ] == fcvx
+                     && dconv.isFullyConvexFast( XX[ i ], scratch ) == fcvx ) ? 1 : 0;
+        nb_fcvx += fcvx ? 1 : 0;
+      }
+    THEN( "Results are the same as the ones of isFullyConvex" ) {
+      REQUIRE( results.size() == XX.size() );
+      REQUIRE( nb_ok == XX.size() );
+      REQUIRE( nb_fcvx > 0 );
+      REQUIRE( nb_fcvx < XX.size() );
+    }
+  }
+  WHEN( "Counting the star of the convex hull of a large simplex" ) {
+    // The projected domain along the longest axis (z) has 71x71 rows,
+    // above the threshold of 4096 rows for the parallel row counting.
+    DConvexity big_dconv( Point( -100, -100, -100 ), Point( 100, 100, 100 ) );
+    const PointRange T = { Point( 0, 0, 0 ), Point( 70, 0, 5 ),
+                           Point( 0, 70, 10 ), Point( 20, 30, 90 ) };
+    const auto P = big_dconv.makePolytope( T );
+    PointRange Y;
+    P.getPoints( Y );
+    THEN( "The number of cells is the size of the lattice set of cells" ) {
+      REQUIRE( big_dconv.sizeStarCvxH( T ) == (KSpace::Integer) big_dconv.StarCvxH( T ).size() );
+    }
+    THEN( "Full convexity is the same as with isFullyConvex, even with a hole" ) {
+      const auto results = big_dconv.areFullyConvex( { Y, T } );
+      REQUIRE( results[ 0 ] == big_dconv.isFullyConvex( Y, false ) );
+      REQUIRE( results[ 1 ] == big_dconv.isFullyConvex( T, false ) );
+      REQUIRE( ! results[ 1 ] );
+      const Point c = Point( 20, 20, 20 );
+      REQUIRE( std::find( Y.begin(), Y.end(), c ) != Y.end() );
+      Y.erase( std::find( Y.begin(), Y.end(), c ) );
+      REQUIRE( ! big_dconv.isFullyConvexFast( Y ) );
+      REQUIRE( ! big_dconv.isFullyConvex( Y, false ) );
+    }
+  }
+  WHEN( "Counting the star of the convex hull of an ellipsoid" ) {
+    PointRange B;
+    for ( int x = -20; x <= 20; x++ )
+      for ( int y = -20; y <= 20; y++ )
+        for ( int z = -20; z <= 20; z++ )
+          if ( x*x + y*y + 2*z*z <= 400 ) B.push_back( Point( x, y, z ) );
+    const auto StarB = dconv.StarCvxH( B );
+    THEN( "The number of cells is the size of the lattice set of cells" ) {
+      REQUIRE( dconv.sizeStarCvxH( B ) == (KSpace::Integer) StarB.size() );
+    }
+    THEN( "Full convexity is the same as with isFullyConvex, even with a hole" ) {
+      REQUIRE( dconv.isFullyConvexFast( B ) == dconv.isFullyConvex( B, false ) );
+      B.erase( std::find( B.begin(), B.end(), Point::zero ) );
+      REQUIRE( ! dconv.isFullyConvexFast( B ) );
+    }
+  }
+}
@@ -130,5 +130,66 @@ SCENARIO( "TangencyComputer::ShortestPaths 3D tests", "[shortest_paths][3d][tang
       // AND_THEN( "This distance is greater or equal to the exacts shortest path" )
       REQUIRE( last_distance_opt*h >= last_distance*h );
     }
+
+  SECTION( "Computing geodesic distances with precomputed cotangent points" )
+    {
+      const double h = 0.5;
+      auto   params  = SH3::defaultParameters();
+      params( "polynomial", "sphere1" )( "gridstep",  h );
+      params( "minAABB", -2)( "maxAABB", 2)( "offset", 1.0 )( "closed", 1 );
+      auto implicit_shape  = SH3::makeImplicitShape3D  ( params );
+      auto digitized_shape = SH3::makeDigitizedImplicitShape3D( implicit_shape, params );
+      auto K            = SH3::getKSpace( params );
+      auto binary_image = SH3::makeBinaryImage(digitized_shape,
+                                               SH3::Domain(K.lowerBound(),K.upperBound()),
+                                               params );
+      auto surface = SH3::makeDigitalSurface( binary_image, K, params );
+      std::vector< Point >    lattice_points;
+      auto pointels = SH3::getPointelRange( surface );
+      for ( auto p : pointels ) lattice_points.push_back( K.uCoords( p ) );
+      const Index nb = lattice_points.size();
+      TangencyComputer< KSpace > TC( K );
+      TC.init( lattice_points.cbegin(), lattice_points.cend() );
+      // Reference distances with bfts.
+      std::vector< Index > sources { 0, nb / 3, nb / 2, nb - 1 };
+      std::vector< Index > targets { nb - 1, 7, nb / 2, 7 };
+      std::vector< std::vector< double > > ref;
+      for ( auto s : sources )
+        {
+          auto SP = TC.makeShortestPaths( sqrt(3.0) );
+          SP.init( s );
+          while ( ! SP.finished() ) SP.expand();
+          ref.push_back( SP.distances() );
+        }
+      auto D = TC.shortestDistances( sources, targets );
+      TC.precomputeCotangentPoints();
+      REQUIRE( TC.hasPrecomputedCotangentPoints() );
+      // THEN( "Precomputed cotangent points are the cotangent points" )
+      unsigned int nb_wrong_lists = 0;
+      for ( Index i = 0; i < nb; i += 10 )
+        {
+          auto R = TC.getCotangentPoints( TC.point( i ) );
+          auto N = TC.precomputedCotangentPoints( i );
+          nb_wrong_lists += std::equal( R.cbegin(), R.cend(), N.first, N.second ) ? 0 : 1;
+        }
+      REQUIRE( nb_wrong_lists == 0 );
+      // AND_THEN( "Geodesic distances are the same with and without precomputations" )
+      auto Dp = TC.shortestDistances( sources, targets, 0.0 );
+      unsigned int nb_wrong_d  = 0;
+      unsigned int nb_wrong_dp = 0;
+      for ( Index i = 0; i < sources.size(); i++ )
+        for ( Index j = 0; j < targets.size(); j++ )
+          {
+            const double d = ref[ i ][ targets[ j ] ];
+            nb_wrong_d  += ( fabs( D [ i ][ j ] - d ) < 1e-10 ) ? 0 : 1;
+            nb_wrong_dp += ( fabs( Dp[ i ][ j ] - d ) < 1e-10 ) ? 0 : 1;
+          }
+      REQUIRE( nb_wrong_d  == 0 );
+      REQUIRE( nb_wrong_dp == 0 );
+      REQUIRE( D[ 3 ][ 0 ] == 0.0 );
+      // AND_THEN( "Init clears the precomputed cotangent points" )
+      TC.init( lattice_points.cbegin(), lattice_points.cend() );
+      REQUIRE( ! TC.hasPrecomputedCotangentPoints() );
+    }
 }  
 
@@ -36,6 +36,7 @@
 #include "DGtal/kernel/SpaceND.h"
 #include "DGtal/kernel/domains/HyperRectDomain.h"
 #include "DGtal/images/ImageSelector.h"
+#include "DGtal/images/ImageContainerByBricks.h"
 
 #include "DGtal/helpers/StdDefs.h"
 #include <map>
@@ -50,6 +51,8 @@ using namespace DGtal;
 typedef DGtal::ImageContainerBySTLVector< Z2i::Domain, DGtal::int32_t> ImageVector2;
 typedef DGtal::ImageContainerBySTLMap< Z2i::Domain, DGtal::int32_t> ImageMap2;
 typedef DGtal::experimental::ImageContainerByHashTree< Z2i::Domain, DGtal::int32_t> ImageHash2;
+typedef DGtal::ImageContainerBySTLVector< Z3i::Domain, DGtal::int32_t> ImageVector3;
+typedef DGtal::ImageContainerByBricks< Z3i::Domain, DGtal::int32_t> ImageBricks3;
 
 template<typename Q>
 static void BM_Constructor(benchmark::State& state)
@@ -162,6 +165,113 @@ static void BM_DomainScan(benchmark::State& state)
 BENCHMARK_TEMPLATE(BM_DomainScan, ImageVector2)->Range(1<<3 , 1 << 10);
 BENCHMARK_TEMPLATE(BM_DomainScan, ImageMap2)->Range(1<<3 , 1 << 10);
 
+/////// 3D neighborhood access: row-major vector vs bricked layout
+
+template<typename Q>
+void FillRandom3(Q &image)
+{
+  for(typename Q::Domain::ConstIterator it = image.domain().begin(), itend=image.domain().end();
+      it != itend; ++it)
+    image.setValue( *it , rand() % 256 );
+}
+
+template<typename Q>
+static void BM_Neighborhood26(benchmark::State& state)
+{
+  typename Q::Domain dom(typename Q::Point().diagonal(0),
+                         typename Q::Point().diagonal(state.range(0)));
+  Q image( dom );
+  FillRandom3( image );
+  const typename Q::Domain inner(typename Q::Point().diagonal(1),
+                                 typename Q::Point().diagonal(state.range(0)-1));
+  const typename Q::Domain cube(typename Q::Point().diagonal(-1),
+                                typename Q::Point().diagonal(1));
+  int64_t sum=0;
+  int64_t cpt=0;
+  while (state.KeepRunning())
+    {
+      for(typename Q::Domain::ConstIterator it = inner.begin(), itend=inner.end();
+          it != itend; ++it)
+        {
+          for(typename Q::Domain::ConstIterator itc = cube.begin(), itcend=cube.end();
+              itc != itcend; ++itc)
+            benchmark::DoNotOptimize( sum += image( *it + *itc ) );
+          cpt++;
+        }
+    }
+  state.SetItemsProcessed(cpt);
+  std::stringstream ss;
+  ss << sum;
+  state.SetLabel(ss.str());
+}
+BENCHMARK_TEMPLATE(BM_Neighborhood26, ImageVector3)->Range(1<<5 , 1 << 8);
+BENCHMARK_TEMPLATE(BM_Neighborhood26, ImageBricks3)->Range(1<<5 , 1 << 8);
+
+// Same sweep with the precomputed in-brick neighbor offsets.
+template<typename Q>
+static void BM_Neighborhood26Offsets(benchmark::State& state)
+{
+  typename Q::Domain dom(typename Q::Point().diagonal(0),
+                         typename Q::Point().diagonal(state.range(0)));
+  Q image( dom );
+  FillRandom3( image );
+  const typename Q::Domain inner(typename Q::Point().diagonal(1),
+                                 typename Q::Point().diagonal(state.range(0)-1));
+  const typename Q::Domain cube(typename Q::Point().diagonal(-1),
+                                typename Q::Point().diagonal(1));
+  const typename Q::Neighborhood neighborhood =
+    Q::neighborhood( std::vector<typename Q::Vector>( cube.begin(), cube.end() ) );
+  std::vector<typename Q::Value> values( neighborhood.offsets.size() );
+  int64_t sum=0;
+  int64_t cpt=0;
+  while (state.KeepRunning())
+    {
+      for(typename Q::Domain::ConstIterator it = inner.begin(), itend=inner.end();
+          it != itend; ++it)
+        {
+          auto out = values.begin();
+          image.writeNeighborValues( *it, neighborhood, out );
+          for ( auto v : values )
+            benchmark::DoNotOptimize( sum += v );
+          cpt++;
+        }
+    }
+  state.SetItemsProcessed(cpt);
+  std::stringstream ss;
+  ss << sum;
+  state.SetLabel(ss.str());
+}
+BENCHMARK_TEMPLATE(BM_Neighborhood26Offsets, ImageBricks3)->Range(1<<5 , 1 << 8);
+
+template<typename Q>
+static void BM_ScanAlongZ(benchmark::State& state)
+{
+  typedef typename Q::Point Point;
+  const int n = state.range(0);
+  typename Q::Domain dom(Point().diagonal(0), Point().diagonal(n - 1));
+  Q image( dom );
+  FillRandom3( image );
+  int64_t sum=0;
+  int64_t cpt=0;
+  while (state.KeepRunning())
+    {
+      // Same access pattern as the last pass of a separable distance transformation.
+      for(int y = 0; y < n; ++y)
+        for(int x = 0; x < n; ++x)
+          for(int z = 0; z < n; ++z)
+            {
+              benchmark::DoNotOptimize( sum += image( Point( x, y, z ) ) );
+              cpt++;
+            }
+    }
+  state.SetItemsProcessed(cpt);
+  std::stringstream ss;
+  ss << sum;
+  state.SetLabel(ss.str());
+}
+BENCHMARK_TEMPLATE(BM_ScanAlongZ, ImageVector3)->Range(1<<5 , 1 << 9);
+BENCHMARK_TEMPLATE(BM_ScanAlongZ, ImageBricks3)->Range(1<<5 , 1 << 9);
+
 
 
 
@@ -0,0 +1,149 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testImageContainerByBricks.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class ImageContainerByBricks.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/images/CImage.h"
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/images/ImageContainerByBricks.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class ImageContainerByBricks.
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE( "Testing ImageContainerByBricks" )
+{
+  typedef ImageContainerByBricks< Z2i::Domain, int >       BrickImage2;
+  typedef ImageContainerByBricks< Z3i::Domain, int >       BrickImage3;
+  typedef ImageContainerByBricks< Z3i::Domain, double, 2 > SmallBrickImage3;
+  typedef ImageContainerBySTLVector< Z3i::Domain, int >    VectorImage3;
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< BrickImage2 > ));
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< BrickImage3 > ));
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< SmallBrickImage3 > ));
+
+  const Z3i::Domain domain( Z3i::Point( -5, 0, 3 ), Z3i::Point( 12, 9, 20 ) );
+  BrickImage3  image( domain, -1 );
+  VectorImage3 ref( domain );
+  int v = 0;
+  for ( auto p : domain )
+    {
+      image.setValue( p, v );
+      ref.setValue( p, v );
+      v = ( 7 * v + 3 ) % 1001;
+    }
+
+  SECTION( "Values are the ones that were set" )
+    {
+      REQUIRE( image.isValid() );
+      REQUIRE( image.nbBricks() == 3 * 2 * 3 );
+      REQUIRE( image.container().size() == 3 * 2 * 3 * 512 );
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        nb_errors += image( p ) != ref( p ) ? 1 : 0;
+      REQUIRE( nb_errors == 0 );
+      REQUIRE( std::equal( image.constRange().begin(), image.constRange().end(),
+                           ref.constRange().begin() ) );
+    }
+
+  SECTION( "The range writes values in the domain order" )
+    {
+      BrickImage3 copy( domain );
+      std::copy( ref.constRange().begin(), ref.constRange().end(),
+                 copy.range().outputIterator() );
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        nb_errors += copy( p ) != ref( p ) ? 1 : 0;
+      REQUIRE( nb_errors == 0 );
+    }
+
+  SECTION( "Bricks partition the domain and their values are contiguous" )
+    {
+      std::size_t nb_points = 0;
+      for ( std::size_t b = 0; b < image.nbBricks(); ++b )
+        {
+          const Z3i::Domain bdomain = image.brickDomain( b );
+          for ( auto p : bdomain )
+            {
+              REQUIRE( domain.isInside( p ) );
+              const std::size_t id = image.linearized( p );
+              REQUIRE( id / 512 == b );
+              REQUIRE( image.point( id ) == p );
+              REQUIRE( image.container()[ id ] == ref( p ) );
+              ++nb_points;
+            }
+        }
+      REQUIRE( nb_points == domain.size() );
+    }
+
+  SECTION( "Works in 2D and with other brick sizes" )
+    {
+      const Z2i::Domain domain2( Z2i::Point( 1, 1 ), Z2i::Point( 20, 5 ) );
+      BrickImage2 image2( domain2 );
+      for ( auto p : domain2 ) image2.setValue( p, p[ 0 ] * 100 + p[ 1 ] );
+      unsigned int nb_errors = 0;
+      for ( auto p : domain2 )
+        nb_errors += image2( p ) != p[ 0 ] * 100 + p[ 1 ] ? 1 : 0;
+      SmallBrickImage3 image3( domain, 0.5 );
+      REQUIRE( SmallBrickImage3::brickSize() == 4 );
+      REQUIRE( image3( domain.upperBound() ) == 0.5 );
+      image3.setValue( domain.upperBound(), 2.5 );
+      REQUIRE( image3( domain.upperBound() ) == 2.5 );
+      REQUIRE( nb_errors == 0 );
+    }
+
+  SECTION( "Neighbor values are read inside and across bricks" )
+    {
+      for ( int radius = 1; radius <= 2; ++radius )
+        {
+          const Z3i::Domain cube( Z3i::Point::diagonal( -radius ), Z3i::Point::diagonal( radius ) );
+          const std::vector< Z3i::Vector > displacements( cube.begin(), cube.end() );
+          const auto neighborhood = BrickImage3::neighborhood( displacements );
+          REQUIRE( neighborhood.radius == radius );
+          const Z3i::Domain inner( domain.lowerBound() + Z3i::Point::diagonal( radius ),
+                                   domain.upperBound() - Z3i::Point::diagonal( radius ) );
+          unsigned int nb_errors = 0;
+          std::vector< int > values;
+          for ( auto p : inner )
+            {
+              values.clear();
+              auto out = std::back_inserter( values );
+              image.writeNeighborValues( p, neighborhood, out );
+              REQUIRE( values.size() == displacements.size() );
+              for ( std::size_t k = 0; k < displacements.size(); ++k )
+                nb_errors += values[ k ] != ref( p + displacements[ k ] ) ? 1 : 0;
+            }
+          REQUIRE( nb_errors == 0 );
+        }
+    }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
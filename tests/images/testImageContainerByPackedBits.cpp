@@ -0,0 +1,168 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testImageContainerByPackedBits.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class ImageContainerByPackedBits.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <random>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/images/CImage.h"
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/images/ImageContainerByPackedBits.h"
+#include "DGtal/topology/NeighborhoodConfigurations.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class ImageContainerByPackedBits.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Fills a packed image and a reference image with random values.
+template <typename PackedImage, typename RefImage>
+void randomFill( PackedImage & packed, RefImage & ref, double ratio, unsigned int seed )
+{
+  std::mt19937 gen( seed );
+  std::bernoulli_distribution B( ratio );
+  for ( auto p : packed.domain() )
+    {
+      const bool v = B( gen );
+      packed.setValue( p, v );
+      ref.setValue( p, v );
+    }
+}
+
+/// @return the configuration of the neighborhood of p, point by point.
+template <typename Image>
+NeighborhoodConfiguration referenceConfiguration( const Image & image,
+                                                  const typename Image::Point & p )
+{
+  typedef typename Image::Point Point;
+  auto masks = functions::mapZeroPointNeighborhoodToConfigurationMask< Point >();
+  NeighborhoodConfiguration cfg = 0;
+  for ( const auto & pm : *masks )
+    if ( image.domain().isInside( p + pm.first ) && image( p + pm.first ) )
+      cfg |= pm.second;
+  return cfg;
+}
+
+TEST_CASE( "Testing ImageContainerByPackedBits" )
+{
+  typedef ImageContainerByPackedBits< Z2i::Domain > PackedImage2;
+  typedef ImageContainerByPackedBits< Z3i::Domain > PackedImage3;
+  typedef ImageContainerBySTLVector< Z3i::Domain, bool > RefImage3;
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< PackedImage2 > ));
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< PackedImage3 > ));
+
+  // Rows of 130 points span 3 words.
+  const Z3i::Domain domain( Z3i::Point( -65, 2, -3 ), Z3i::Point( 64, 8, 4 ) );
+  PackedImage3 image( domain );
+  RefImage3    ref( domain );
+  randomFill( image, ref, 0.4, 3 );
+
+  SECTION( "Values are the ones that were set" )
+    {
+      REQUIRE( image.isValid() );
+      REQUIRE( image.wordsPerRow() == 3 );
+      REQUIRE( image.nbRows() == 7 * 8 );
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        nb_errors += image( p ) != ref( p ) ? 1 : 0;
+      REQUIRE( nb_errors == 0 );
+      REQUIRE( std::equal( image.constRange().begin(), image.constRange().end(),
+                           ref.constRange().begin() ) );
+    }
+
+  SECTION( "Counts are the same as point by point" )
+    {
+      const auto n = std::count( ref.begin(), ref.end(), true );
+      REQUIRE( image.count() == (PackedImage3::Size) n );
+      const Z3i::Point lo( -70, 3, 0 );
+      const Z3i::Point up( 63, 6, 10 );
+      std::size_t n_box = 0;
+      for ( auto p : Z3i::Domain( lo.sup( domain.lowerBound() ), up.inf( domain.upperBound() ) ) )
+        n_box += ref( p ) ? 1 : 0;
+      REQUIRE( image.count( lo, up ) == n_box );
+      REQUIRE( image.count( Z3i::Point( 1, 2, 3 ), Z3i::Point( 1, 2, 3 ) )
+               == ( ref( Z3i::Point( 1, 2, 3 ) ) ? 1u : 0u ) );
+      REQUIRE( image.count( Z3i::Point( 0, 9, 0 ), Z3i::Point( 5, 12, 0 ) ) == 0 );
+    }
+
+  SECTION( "Bitwise operations and complement are done point by point" )
+    {
+      PackedImage3 other( domain );
+      RefImage3    ref_other( domain );
+      randomFill( other, ref_other, 0.5, 5 );
+      PackedImage3 i_and = image, i_or = image, i_xor = image, i_not = image;
+      i_and &= other;
+      i_or  |= other;
+      i_xor ^= other;
+      i_not.flip();
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        {
+          nb_errors += i_and( p ) != ( ref( p ) && ref_other( p ) ) ? 1 : 0;
+          nb_errors += i_or ( p ) != ( ref( p ) || ref_other( p ) ) ? 1 : 0;
+          nb_errors += i_xor( p ) != ( ref( p ) != ref_other( p ) ) ? 1 : 0;
+          nb_errors += i_not( p ) == ref( p ) ? 1 : 0;
+        }
+      REQUIRE( nb_errors == 0 );
+      REQUIRE( i_not.count() == domain.size() - image.count() );
+      PackedImage3 full( domain, true );
+      REQUIRE( full.count() == domain.size() );
+    }
+
+  SECTION( "Images are filled from a predicate" )
+    {
+      PackedImage3 thresholded( domain );
+      thresholded.setFromPredicate( [] ( const Z3i::Point & p )
+                                    { return p[ 0 ] * p[ 0 ] + 4 * p[ 1 ] * p[ 2 ] > 100; } );
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        nb_errors += thresholded( p ) != ( p[ 0 ] * p[ 0 ] + 4 * p[ 1 ] * p[ 2 ] > 100 ) ? 1 : 0;
+      REQUIRE( nb_errors == 0 );
+    }
+
+  SECTION( "Neighborhood configurations are the same as point by point" )
+    {
+      unsigned int nb_errors = 0;
+      for ( auto p : domain )
+        nb_errors += image.getNeighborhoodConfiguration( p )
+          != referenceConfiguration( ref, p ) ? 1 : 0;
+      REQUIRE( nb_errors == 0 );
+      // In 2D, with rows of exactly one word.
+      const Z2i::Domain domain2( Z2i::Point( 0, 0 ), Z2i::Point( 63, 9 ) );
+      PackedImage2 image2( domain2 );
+      ImageContainerBySTLVector< Z2i::Domain, bool > ref2( domain2 );
+      randomFill( image2, ref2, 0.5, 7 );
+      for ( auto p : domain2 )
+        nb_errors += image2.getNeighborhoodConfiguration( p )
+          != referenceConfiguration( ref2, p ) ? 1 : 0;
+      REQUIRE( nb_errors == 0 );
+    }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
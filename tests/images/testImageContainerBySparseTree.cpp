@@ -0,0 +1,168 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testImageContainerBySparseTree.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class ImageContainerBySparseTree.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <random>
+#include <set>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/images/CImage.h"
+#include "DGtal/kernel/sets/CDigitalSet.h"
+#include "DGtal/images/ImageContainerBySparseTree.h"
+#include "DGtal/topology/DigitalSetBoundary.h"
+#include "DGtal/topology/LightImplicitDigitalSurface.h"
+#include "DGtal/topology/helpers/Surfaces.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class ImageContainerBySparseTree.
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE( "Testing ImageContainerBySparseTree" )
+{
+  typedef ImageContainerBySparseTree< Z3i::Domain >           SparseSet3;
+  typedef ImageContainerBySparseTree< Z3i::Domain, int >      SparseImage3;
+  typedef ImageContainerBySparseTree< Z2i::Domain, int, 2, 2 > SparseImage2;
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< SparseSet3 > ));
+  BOOST_CONCEPT_ASSERT(( concepts::CDigitalSet< SparseSet3 > ));
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< SparseImage3 > ));
+  BOOST_CONCEPT_ASSERT(( concepts::CImage< SparseImage2 > ));
+
+  // Spans several tiles along each axis, with a negative lower bound.
+  const Z3i::Domain domain( Z3i::Point( -200, -3, 10 ), Z3i::Point( 300, 260, 140 ) );
+  std::mt19937 gen( 7 );
+  std::uniform_int_distribution<int> X( -200, 300 ), Y( -3, 260 ), Z( 10, 140 );
+  std::set<Z3i::Point> ref;
+  SparseSet3 set( domain );
+  for ( int i = 0; i < 5000; ++i )
+    {
+      const Z3i::Point p( X( gen ), Y( gen ), Z( gen ) );
+      set.insert( p );
+      ref.insert( p );
+    }
+
+  SECTION( "Set services are the same as with a std::set" )
+    {
+      REQUIRE( set.isValid() );
+      REQUIRE( set.size() == ref.size() );
+      REQUIRE( ! set.empty() );
+      std::set<Z3i::Point> visited( set.begin(), set.end() );
+      REQUIRE( visited == ref );
+      unsigned int nb_errors = 0;
+      for ( auto p : ref )
+        nb_errors += ( set.find( p ) != set.end() && *set.find( p ) == p
+                       && set( p ) ) ? 0 : 1;
+      REQUIRE( nb_errors == 0 );
+      REQUIRE( set.find( Z3i::Point( 400, 0, 0 ) ) == set.end() );
+      Z3i::Point lo, up, ref_lo = *ref.begin(), ref_up = *ref.begin();
+      for ( auto p : ref ) { ref_lo = ref_lo.inf( p ); ref_up = ref_up.sup( p ); }
+      set.computeBoundingBox( lo, up );
+      REQUIRE( lo == ref_lo );
+      REQUIRE( up == ref_up );
+    }
+
+  SECTION( "Erased points are no longer active, and pruning keeps the others" )
+    {
+      unsigned int i = 0;
+      for ( auto p : ref )
+        if ( i++ % 3 == 0 )
+          REQUIRE( set.erase( p ) == 1 );
+      REQUIRE( set.erase( *ref.begin() ) == 0 );
+      const auto nb_leaves = set.nbLeaves();
+      // Erases a whole leaf with iterators.
+      auto first = set.begin();
+      auto last  = first;
+      while ( last != set.end() && ( *last - *first ).normInfinity() < 8 ) ++last;
+      set.erase( first, last );
+      REQUIRE( set.isValid() );
+      const std::set<Z3i::Point> before( set.begin(), set.end() );
+      REQUIRE( before.size() == set.size() );
+      set.prune();
+      REQUIRE( set.isValid() );
+      REQUIRE( set.nbLeaves() < nb_leaves );
+      const std::set<Z3i::Point> after( set.begin(), set.end() );
+      REQUIRE( after == before );
+      for ( auto p : after ) REQUIRE( set( p ) );
+      set.clear();
+      REQUIRE( set.empty() );
+      REQUIRE( set.begin() == set.end() );
+      REQUIRE( set.nbNodes() == 0 );
+    }
+
+  SECTION( "Image values are stored, and background values are inactive" )
+    {
+      SparseImage3 image( domain, -1000 );
+      for ( auto p : ref ) image.setValue( p, p[ 0 ] + p[ 1 ] * p[ 2 ] );
+      image.setValue( *ref.begin(), -1000 );
+      REQUIRE( image.size() == ref.size() - 1 );
+      REQUIRE( image( *ref.begin() ) == -1000 );
+      REQUIRE( image( Z3i::Point( 300, 260, 140 ) ) ==
+               ( ref.count( Z3i::Point( 300, 260, 140 ) ) ? 300 + 260 * 140 : -1000 ) );
+      unsigned int nb_errors = 0;
+      for ( auto p : image )
+        nb_errors += image( p ) == p[ 0 ] + p[ 1 ] * p[ 2 ] ? 0 : 1;
+      REQUIRE( nb_errors == 0 );
+      // 2D, small leaves and nodes, through the range.
+      const Z2i::Domain domain2( Z2i::Point( -9, 0 ), Z2i::Point( 30, 17 ) );
+      SparseImage2 image2( domain2 );
+      std::vector<int> values;
+      for ( auto p : domain2 ) values.push_back( ( p[ 0 ] * p[ 1 ] ) % 5 == 0 ? p[ 0 ] : 0 );
+      std::copy( values.begin(), values.end(), image2.range().outputIterator() );
+      REQUIRE( std::equal( values.begin(), values.end(), image2.constRange().begin() ) );
+      REQUIRE( image2.size() == (SparseImage2::Size)
+               std::count_if( values.begin(), values.end(), [] ( int v ) { return v != 0; } ) );
+    }
+
+  SECTION( "Boundaries are the same as with Z3i::DigitalSet" )
+    {
+      const Z3i::Domain bdomain( Z3i::Point( -20, -20, -20 ), Z3i::Point( 20, 20, 20 ) );
+      SparseSet3 ball( bdomain );
+      Z3i::DigitalSet ref_ball( bdomain );
+      for ( auto p : bdomain )
+        if ( p.squaredNorm() <= 15 * 15 )
+          {
+            ball.insert( p );
+            ref_ball.insert( p );
+          }
+      Z3i::KSpace K;
+      K.init( bdomain.lowerBound(), bdomain.upperBound(), true );
+      DigitalSetBoundary< Z3i::KSpace, SparseSet3 >      boundary( K, ball );
+      DigitalSetBoundary< Z3i::KSpace, Z3i::DigitalSet > ref_boundary( K, ref_ball );
+      REQUIRE( boundary.nbSurfels() == ref_boundary.nbSurfels() );
+      // The image is also a point predicate for implicit surfaces.
+      typedef LightImplicitDigitalSurface< Z3i::KSpace, SparseSet3 > Surface;
+      const auto bel = Surfaces< Z3i::KSpace >::findABel( K, ball, 10000 );
+      Surface surface( K, ball, SurfelAdjacency< 3 >( true ), bel );
+      std::size_t nb = 0;
+      for ( auto it = surface.begin(), itE = surface.end(); it != itE; ++it ) ++nb;
+      REQUIRE( nb == ref_boundary.nbSurfels() );
+    }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
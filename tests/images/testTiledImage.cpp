@@ -29,6 +29,8 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 #include <iostream>
+#include <thread>
+#include <vector>
 #include "DGtal/base/Common.h"
 #include "DGtal/helpers/StdDefs.h"
 
@@ -327,6 +329,110 @@ bool test_range_constRange()
     return nbok == nb;
 }
 
+bool testLRUAndPrefetch()
+{
+    unsigned int nbok = 0;
+    unsigned int nb = 0;
+
+    trace.beginBlock("Testing TiledImage with a LRU cache and prefetching");
+
+    typedef ImageContainerBySTLVector<Z3i::Domain, int> VImage;
+    VImage image(Z3i::Domain(Z3i::Point(0,0,0), Z3i::Point(15,15,15)));
+
+    int i = 1;
+    for (VImage::Iterator it = image.begin(); it != image.end(); ++it)
+        *it = i++;
+    const VImage original = image;
+
+    typedef ImageFactoryFromImage<VImage> MyImageFactoryFromImage;
+    typedef MyImageFactoryFromImage::OutputImage OutputImage;
+    MyImageFactoryFromImage imageFactoryFromImage(image);
+
+    typedef ImageCacheReadPolicyLRU<OutputImage, MyImageFactoryFromImage> MyImageCacheReadPolicyLRU;
+    typedef ImageCacheWritePolicyWT<OutputImage, MyImageFactoryFromImage> MyImageCacheWritePolicyWT;
+    MyImageCacheReadPolicyLRU imageCacheReadPolicyLRU(imageFactoryFromImage, 8);
+    MyImageCacheWritePolicyWT imageCacheWritePolicyWT(imageFactoryFromImage);
+
+    typedef TiledImage<VImage, MyImageFactoryFromImage, MyImageCacheReadPolicyLRU, MyImageCacheWritePolicyWT> MyTiledImage;
+    BOOST_CONCEPT_ASSERT(( concepts::CImage< MyTiledImage > ));
+    // 4x4x4 tiles of 4x4x4 points
+    MyTiledImage tiledImage(imageFactoryFromImage, imageCacheReadPolicyLRU, imageCacheWritePolicyWT, 4);
+
+    // Fills the cache with 8 tiles, uses again the first one, then loads a 9th tile:
+    // the second tile is the least recently used one.
+    for (int t = 0; t < 8; t++)
+      tiledImage(Z3i::Point(4*(t%4), 4*(t/4), 0));
+    tiledImage(Z3i::Point(1,1,1));
+    tiledImage(Z3i::Point(0,8,0));
+    trace.info() << "After 10 reads: " << tiledImage << endl;
+    nbok += (tiledImage.getCacheMissRead() == 9 && tiledImage.getCacheEvictions() == 1) ? 1 : 0;
+    nb++;
+    tiledImage(Z3i::Point(2,2,2));
+    nbok += (tiledImage.getCacheMissRead() == 9) ? 1 : 0;
+    nb++;
+    tiledImage(Z3i::Point(4,0,0));
+    nbok += (tiledImage.getCacheMissRead() == 10) ? 1 : 0;
+    nb++;
+
+    trace.info() << "(" << nbok << "/" << nb << ") " << endl;
+
+    // Concurrent writes of the opposite values, each thread on its own layer of tiles.
+    const int nbThreads = 4;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nbThreads; t++)
+      threads.emplace_back([&tiledImage, &original, t] ()
+        {
+          for (Z3i::Domain::ConstIterator it = original.domain().begin(); it != original.domain().end(); ++it)
+            if ((*it)[2] / 4 == t)
+              tiledImage.setValue(*it, -original(*it));
+        });
+    for (auto & th : threads) th.join();
+    threads.clear();
+
+    // Concurrent reads of the whole image.
+    tiledImage.clearCacheAndResetCacheMisses();
+    const long size = (long) original.domain().size();
+    const long expected = - size * (size + 1) / 2;
+    std::vector<long> sums(nbThreads, 0);
+    for (int t = 0; t < nbThreads; t++)
+      threads.emplace_back([&tiledImage, &original, &sums, t] ()
+        {
+          for (Z3i::Domain::ConstIterator it = original.domain().begin(); it != original.domain().end(); ++it)
+            sums[t] += tiledImage(*it);
+        });
+    for (auto & th : threads) th.join();
+    trace.info() << "After concurrent reads: " << tiledImage << endl;
+    for (int t = 0; t < nbThreads; t++)
+      {
+        nbok += (sums[t] == expected) ? 1 : 0;
+        nb++;
+      }
+    nbok += (tiledImage.getCacheHits() + tiledImage.getCacheMissRead() == (unsigned long) (nbThreads * size)) ? 1 : 0;
+    nb++;
+
+    trace.info() << "(" << nbok << "/" << nb << ") " << endl;
+
+    // A miss prefetches the adjacent tiles.
+    tiledImage.clearCacheAndResetCacheMisses();
+    tiledImage.setPrefetchNeighbors(true);
+    tiledImage(Z3i::Point(5,5,5));
+    tiledImage.waitPrefetches();
+    trace.info() << "After prefetching: " << tiledImage << endl;
+    nbok += (tiledImage.getCachePrefetches() == 6) ? 1 : 0;
+    nb++;
+    nbok += (tiledImage(Z3i::Point(0,5,5)) == -original(Z3i::Point(0,5,5))
+             && tiledImage(Z3i::Point(5,8,5)) == -original(Z3i::Point(5,8,5))
+             && tiledImage(Z3i::Point(5,5,11)) == -original(Z3i::Point(5,5,11))
+             && tiledImage.getCacheMissRead() == 1) ? 1 : 0;
+    nb++;
+
+    trace.info() << "(" << nbok << "/" << nb << ") " << endl;
+
+    trace.endBlock();
+
+    return nbok == nb;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Standard services - public :
 
@@ -338,7 +444,7 @@ int main( int argc, char** argv )
         trace.info() << " " << argv[ i ];
     trace.info() << endl;
 
-    bool res = testSimple() && test3d() && testIterators() && test_range_constRange(); // && ... other tests
+    bool res = testSimple() && test3d() && testIterators() && test_range_constRange() && testLRUAndPrefetch(); // && ... other tests
 
     trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
     trace.endBlock();
@@ -32,6 +32,7 @@
 
 #include <cstddef>
 #include <cmath>
+#include <vector>
 
 #include "DGtalCatch.h"
 
@@ -347,3 +348,43 @@ BENCH_LINEARIZER( 2, RowMajorStorage )
 BENCH_LINEARIZER( 3, RowMajorStorage )
 BENCH_LINEARIZER( 4, RowMajorStorage )
 BENCH_LINEARIZER( 5, RowMajorStorage )
+
+TEST_CASE( "Testing Linearizer with BrickedStorage", "[test][bricked]" )
+{
+  typedef SpaceND<3> Space;
+  typedef HyperRectDomain<Space> Domain;
+  typedef Space::Point Point;
+  typedef Linearizer< Domain, BrickedStorage<2> > BrickLinearizer;
+
+  // Extents that are not multiples of the brick size.
+  const Domain domain( Point( -3, 2, 5 ), Point( 6, 7, 15 ) );
+  const Point extent = domain.upperBound() - domain.lowerBound() + Point::diagonal(1);
+  const std::size_t size = BrickLinearizer::getSize( extent );
+  REQUIRE( size == 3*2*3 * 4*4*4 );
+
+  SECTION( "Indices of domain points are distinct and are de-linearized back" )
+    {
+      std::vector<bool> used( size, false );
+      for ( auto const& pt : domain )
+        {
+          const std::size_t id = BrickLinearizer::getIndex( pt, domain );
+          REQUIRE( id < size );
+          REQUIRE( ! used[ id ] );
+          used[ id ] = true;
+          REQUIRE( BrickLinearizer::getIndex( pt, domain.lowerBound(), extent ) == id );
+          REQUIRE( BrickLinearizer::getIndex( pt - domain.lowerBound(), extent ) == id );
+          REQUIRE( BrickLinearizer::getPoint( id, domain ) == pt );
+          REQUIRE( BrickLinearizer::getPoint( id, domain.lowerBound(), extent ) == pt );
+          REQUIRE( BrickLinearizer::getPoint( id, extent ) == pt - domain.lowerBound() );
+        }
+    }
+
+  SECTION( "Points of a brick are contiguous" )
+    {
+      const Point lo = domain.lowerBound();
+      for ( auto const& pt : Domain( lo, lo + Point::diagonal(3) ) )
+        REQUIRE( BrickLinearizer::getIndex( pt, domain ) < 4*4*4 );
+      REQUIRE( BrickLinearizer::getIndex( lo + Point( 4, 0, 0 ), domain ) == 4*4*4 );
+      REQUIRE( BrickLinearizer::getIndex( lo + Point( 0, 4, 0 ), domain ) == 3 * 4*4*4 );
+    }
+}
@@ -228,4 +228,31 @@ TEST_CASE("Basic voxelization test", "[voxelization]")
     //hard coded test.
     REQUIRE( outputSet.size() == 4162 );
   }
+  // ---------------------------------------------------------
+  SECTION("Mesh voxelization is the union of face voxelizations, clipped by the domain")
+  {
+    Mesh<Z3i::RealPoint> inputMesh;
+    MeshReader<Z3i::RealPoint>::importOFFFile(testPath +"/samples/box.off" , inputMesh);
+    Z3i::Domain domain( Point(-30,-30,-5), Point(5,30,30));
+    DigitalSet outputSet(domain);
+    DigitalSet expectedSet(domain);
+    MeshVoxelizer26 voxelizer;
+
+    voxelizer.voxelize(outputSet, inputMesh, 10.0 );
+    for(unsigned int i = 0; i < inputMesh.nbFaces(); ++i)
+    {
+      const auto face = inputMesh.getFace(i);
+      for(size_t j = 0; j + 2 < face.size(); ++j)
+        voxelizer.voxelize(expectedSet, inputMesh.getVertex(face[0]),
+                           inputMesh.getVertex(face[j+1]),
+                           inputMesh.getVertex(face[j+2]), 10.0 );
+    }
+
+    CAPTURE(outputSet.size());
+    //hard coded test.
+    REQUIRE( outputSet.size() == 1911 );
+    REQUIRE( outputSet.size() == expectedSet.size() );
+    for(auto p: expectedSet)
+      REQUIRE( outputSet(p) );
+  }
 }
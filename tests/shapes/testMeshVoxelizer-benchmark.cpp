@@ -0,0 +1,134 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testMeshVoxelizer-benchmark.cpp
+ * @ingroup Tests
+ *
+ * Scaling benchmark of MeshVoxelizer with respect to the number of
+ * threads (from 1 to the number of available cores when DGtal is
+ * built with OpenMP). The mesh is a sphere with about 2 x nbLat x
+ * nbLon triangles (one million by default).
+ *
+ * Usage: testMeshVoxelizer-benchmark [nbLat [nbLon [radius]]]
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include "DGtal/base/Common.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/shapes/Mesh.h"
+#include "DGtal/shapes/MeshVoxelizer.h"
+#include "DGtalBenchmarkThreads.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for benchmarking class MeshVoxelizer.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef Mesh<Z3i::RealPoint> InputMesh;
+typedef MeshVoxelizer<Z3i::DigitalSet, 26> Voxelizer;
+
+/**
+ * Builds a latitude/longitude triangulation of a sphere.
+ *
+ * @param[out] mesh the output mesh.
+ * @param nbLat the number of parallels.
+ * @param nbLon the number of meridians.
+ * @param radius the radius of the sphere.
+ */
+void makeSphere( InputMesh & mesh, int nbLat, int nbLon, double radius )
+{
+  const double pi = M_PI;
+  mesh.addVertex( Z3i::RealPoint( 0., 0., radius ) );
+  for ( int i = 1; i < nbLat; ++i )
+    for ( int j = 0; j < nbLon; ++j )
+      {
+        const double theta = pi * i / nbLat;
+        const double phi   = 2. * pi * j / nbLon;
+        mesh.addVertex( Z3i::RealPoint( radius * sin( theta ) * cos( phi ),
+                                        radius * sin( theta ) * sin( phi ),
+                                        radius * cos( theta ) ) );
+      }
+  mesh.addVertex( Z3i::RealPoint( 0., 0., -radius ) );
+  const InputMesh::Index south = 1 + ( nbLat - 1 ) * nbLon;
+  auto v = [nbLon] ( int i, int j ) -> InputMesh::Index
+    { return 1 + ( i - 1 ) * nbLon + ( j % nbLon ); };
+  for ( int j = 0; j < nbLon; ++j )
+    {
+      mesh.addTriangularFace( 0, v( 1, j ), v( 1, j + 1 ) );
+      mesh.addTriangularFace( south, v( nbLat - 1, j + 1 ), v( nbLat - 1, j ) );
+    }
+  for ( int i = 1; i + 1 < nbLat; ++i )
+    for ( int j = 0; j < nbLon; ++j )
+      {
+        mesh.addTriangularFace( v( i, j ), v( i + 1, j ), v( i + 1, j + 1 ) );
+        mesh.addTriangularFace( v( i, j ), v( i + 1, j + 1 ), v( i, j + 1 ) );
+      }
+}
+
+/**
+ * Voxelizes the mesh.
+ *
+ * @param mesh the input mesh.
+ * @param domain the domain of the output set.
+ * @return the elapsed time in milliseconds.
+ */
+double runVoxelizer( const InputMesh & mesh, const Z3i::Domain & domain )
+{
+  Z3i::DigitalSet output( domain );
+  Voxelizer voxelizer;
+  trace.beginBlock( "MeshVoxelizer" );
+  voxelizer.voxelize( output, mesh );
+  trace.info() << "Nb voxels = " << output.size() << std::endl;
+  return trace.endBlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Benchmarking MeshVoxelizer thread scaling" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  const int    nbLat  = argc > 1 ? atoi( argv[ 1 ] ) : 500;
+  const int    nbLon  = argc > 2 ? atoi( argv[ 2 ] ) : 1000;
+  const double radius = argc > 3 ? atof( argv[ 3 ] ) : 200.;
+
+  InputMesh mesh;
+  makeSphere( mesh, nbLat, nbLon, radius );
+  trace.info() << "Nb triangles = " << mesh.nbFaces() << std::endl;
+  const int r = static_cast<int>( std::ceil( radius ) ) + 2;
+  const Z3i::Domain domain( Z3i::Point::diagonal( -r ), Z3i::Point::diagonal( r ) );
+
+  benchmarkThreadScaling( [&mesh, &domain] { return runVoxelizer( mesh, domain ); } );
+
+  trace.endBlock();
+  return 0;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
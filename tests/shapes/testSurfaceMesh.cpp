@@ -514,3 +514,84 @@ SCENARIO( "SurfaceMesh< RealPoint3 > restore lantern with flips tests", "[surfme
   }
 }
   
+
+SCENARIO( "SurfaceMesh< RealPoint3 > edge lookup tests", "[surfmesh][edges]" )
+{
+  typedef PointVector<3,double>                      RealPoint;
+  typedef PointVector<3,double>                      RealVector;
+  typedef SurfaceMesh< RealPoint, RealVector >       PolygonMesh;
+  typedef PolygonMesh::Edge                          Edge;
+  typedef PolygonMesh::Face                          Face;
+  typedef PolygonMesh::VertexPair                    VertexPair;
+  typedef SurfaceMeshHelper< RealPoint, RealVector > PolygonMeshHelper;
+  typedef PolygonMeshHelper::NormalsType             NormalsType;
+  auto meshTorus   = PolygonMeshHelper::makeTorus( 3.0, 1.0, RealPoint::zero,
+                                                   10, 10, 0, NormalsType::NO_NORMALS );
+  auto meshNonManifold = makeNonManifoldBoundary();
+  for ( auto mesh : { meshTorus, meshNonManifold } )
+    {
+      // Reference edges, computed with ordered maps.
+      std::map< VertexPair, PolygonMesh::Faces > left, right;
+      std::set< VertexPair > ref_edges;
+      for ( Face f = 0; f < mesh.nbFaces(); f++ )
+        {
+          const auto & iv = mesh.incidentVertices( f );
+          for ( std::size_t i = 0; i < iv.size(); i++ )
+            {
+              const auto vi = iv[ i ];
+              const auto vj = iv[ ( i + 1 ) % iv.size() ];
+              if ( vi < vj ) left [ std::make_pair( vi, vj ) ].push_back( f );
+              else           right[ std::make_pair( vj, vi ) ].push_back( f );
+              ref_edges.insert( std::minmax( vi, vj ) );
+            }
+        }
+      THEN( "Edges are numbered in lexicographic order with their faces" ) {
+        REQUIRE( mesh.nbEdges() == ref_edges.size() );
+        Edge e = 0;
+        for ( auto vp : ref_edges )
+          {
+            REQUIRE( mesh.edgeVertices( e ) == vp );
+            REQUIRE( mesh.edgeLeftFaces ( e ) == left [ vp ] );
+            REQUIRE( mesh.edgeRightFaces( e ) == right[ vp ] );
+            REQUIRE( mesh.edgeFaces( e ).size() == left[ vp ].size() + right[ vp ].size() );
+            REQUIRE( mesh.makeEdge( vp.first, vp.second ) == e );
+            REQUIRE( mesh.makeEdge( vp.second, vp.first ) == e );
+            e++;
+          }
+        REQUIRE( mesh.makeEdge( 0, 0 ) == mesh.nbEdges() );
+      }
+      THEN( "Neighbor vertices are the vertices sharing an edge" ) {
+        for ( PolygonMesh::Vertex v = 0; v < mesh.nbVertices(); v++ )
+          {
+            PolygonMesh::Vertices expected;
+            for ( auto vp : ref_edges )
+              if      ( vp.first  == v ) expected.push_back( vp.second );
+              else if ( vp.second == v ) expected.push_back( vp.first );
+            std::sort( expected.begin(), expected.end() );
+            REQUIRE( mesh.neighborVertices( v ) == expected );
+          }
+      }
+    }
+  WHEN( "Flipping torus edges" ) {
+    Edge nb_flipped = 0;
+    for ( Edge e = 0; e < meshTorus.nbEdges(); e += 3 )
+      {
+        const auto ij = meshTorus.edgeVertices ( e );
+        const auto kl = meshTorus.otherDiagonal( e );
+        if ( meshTorus.makeEdge( kl.first, kl.second ) != meshTorus.nbEdges() )
+          continue;
+        meshTorus.flip( e, false );
+        nb_flipped++;
+        REQUIRE( meshTorus.makeEdge( kl.first, kl.second ) == e );
+        REQUIRE( meshTorus.makeEdge( ij.first, ij.second ) == meshTorus.nbEdges() );
+      }
+    THEN( "Every edge is found from its vertices" ) {
+      REQUIRE( nb_flipped > 0 );
+      for ( Edge e = 0; e < meshTorus.nbEdges(); e++ )
+        {
+          const auto ij = meshTorus.edgeVertices( e );
+          REQUIRE( meshTorus.makeEdge( ij.second, ij.first ) == e );
+        }
+    }
+  }
+}
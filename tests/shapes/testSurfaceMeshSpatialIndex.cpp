@@ -0,0 +1,224 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testSurfaceMeshSpatialIndex.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class SurfaceMeshSpatialIndex.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/kernel/PointVector.h"
+#include "DGtal/shapes/SurfaceMesh.h"
+#include "DGtal/shapes/SurfaceMeshHelper.h"
+#include "DGtal/shapes/SurfaceMeshSpatialIndex.h"
+#include "DGtal/geometry/meshes/SurfaceMeshMeasure.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class SurfaceMeshSpatialIndex.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef PointVector<3,double>                          RealPoint;
+typedef PointVector<3,double>                          RealVector;
+typedef SurfaceMesh< RealPoint, RealVector >           PolygonMesh;
+typedef SurfaceMeshHelper< RealPoint, RealVector >     PolygonMeshHelper;
+typedef PolygonMeshHelper::NormalsType                 NormalsType;
+typedef SurfaceMeshSpatialIndex< RealPoint, RealVector > SpatialIndex;
+typedef SpatialIndex::Faces                            Faces;
+typedef SpatialIndex::RealPoints                       RealPoints;
+
+/// @return the faces at distance at most r from p, by checking all faces.
+Faces bruteForceFacesInBall( const SpatialIndex & index, const RealPoint & p, double r )
+{
+  Faces result;
+  for ( PolygonMesh::Face f = 0; f < index.mesh().nbFaces(); ++f )
+    if ( index.distanceToFace( p, f ) <= r ) result.push_back( f );
+  return result;
+}
+
+/// @return the distance from p to the nearest face, by checking all faces.
+double bruteForceNearestDistance( const SpatialIndex & index, const RealPoint & p )
+{
+  double d = std::numeric_limits<double>::infinity();
+  for ( PolygonMesh::Face f = 0; f < index.mesh().nbFaces(); ++f )
+    d = std::min( d, index.distanceToFace( p, f ) );
+  return d;
+}
+
+/// @return the faces with positive inclusion ratio, by checking all faces.
+PolygonMesh::WeightedFaces
+bruteForceFacesInclusions( const PolygonMesh & mesh, const RealPoint & p, double r )
+{
+  PolygonMesh::WeightedFaces result;
+  for ( PolygonMesh::Face f = 0; f < mesh.nbFaces(); ++f )
+    {
+      const double w = mesh.faceInclusionRatio( p, r, f );
+      if ( w > 0.0 ) result.push_back( std::make_pair( f, w ) );
+    }
+  return result;
+}
+
+/// @return n random points in the cube [-a,a]^3.
+RealPoints randomPoints( std::mt19937 & gen, std::size_t n, double a )
+{
+  std::uniform_real_distribution<double> U( -a, a );
+  RealPoints points( n );
+  for ( auto & p : points ) p = RealPoint( U( gen ), U( gen ), U( gen ) );
+  return points;
+}
+
+/// Checks ball and nearest face queries against brute force.
+void checkQueries( const SpatialIndex & index, const RealPoints & points, double r )
+{
+  for ( auto p : points )
+    {
+      REQUIRE( index.facesInBall( p, r ) == bruteForceFacesInBall( index, p, r ) );
+      const auto fd = index.nearestFace( p );
+      REQUIRE( fd.first < index.mesh().nbFaces() );
+      REQUIRE( fd.second == Approx( index.distanceToFace( p, fd.first ) ) );
+      REQUIRE( fd.second == Approx( bruteForceNearestDistance( index, p ) ) );
+    }
+}
+
+SCENARIO( "SurfaceMeshSpatialIndex< RealPoint3 > queries", "[surfmesh][spatialindex]" )
+{
+  std::mt19937 gen( 7 );
+  GIVEN( "A torus with radii 3 and 1 and its spatial index" ) {
+    PolygonMesh mesh = PolygonMeshHelper::makeTorus( 3.0, 1.0, RealPoint::zero,
+                                                     20, 30, 0, NormalsType::NO_NORMALS );
+    SpatialIndex index( mesh );
+    REQUIRE( index.isValid() );
+    REQUIRE( index.nbCells() > 0 );
+    const RealPoints points = randomPoints( gen, 100, 5.0 );
+    THEN( "Ball and nearest face queries are the same as brute force" ) {
+      checkQueries( index, points, 0.7 );
+    }
+    THEN( "Points far from the mesh have a nearest face" ) {
+      checkQueries( index, randomPoints( gen, 10, 50.0 ), 0.5 );
+    }
+    THEN( "Queries do not depend on the cell size" ) {
+      SpatialIndex small_index( mesh, 0.1 );
+      SpatialIndex big_index  ( mesh, 10.0 );
+      for ( auto p : points )
+        {
+          REQUIRE( small_index.facesInBall( p, 0.7 ) == index.facesInBall( p, 0.7 ) );
+          REQUIRE( big_index.facesInBall( p, 0.7 )   == index.facesInBall( p, 0.7 ) );
+          REQUIRE( small_index.nearestFace( p ).second == Approx( index.nearestFace( p ).second ) );
+        }
+    }
+    THEN( "Face inclusions in balls are the same as brute force" ) {
+      for ( auto p : points )
+        {
+          auto wfaces   = index.computeFacesInclusionsInBall( 0.7, p );
+          auto expected = bruteForceFacesInclusions( mesh, p, 0.7 );
+          REQUIRE( wfaces.size() == expected.size() );
+          for ( std::size_t i = 0; i < wfaces.size(); ++i )
+            {
+              REQUIRE( wfaces[ i ].first  == expected[ i ].first );
+              REQUIRE( wfaces[ i ].second == Approx( expected[ i ].second ) );
+            }
+        }
+    }
+    THEN( "Batched queries are the same as single queries" ) {
+      auto balls   = index.facesInBalls( points, 0.7 );
+      auto nearest = index.nearestFaces( points );
+      REQUIRE( balls.size()   == points.size() );
+      REQUIRE( nearest.size() == points.size() );
+      for ( std::size_t i = 0; i < points.size(); ++i )
+        {
+          REQUIRE( balls[ i ] == index.facesInBall( points[ i ], 0.7 ) );
+          REQUIRE( nearest[ i ] == index.nearestFace( points[ i ] ) );
+        }
+    }
+    THEN( "Ball measures gather all the faces close to the centers" ) {
+      SurfaceMeshMeasure< RealPoint, RealVector, double > area( &mesh, 0.0 );
+      area.kMeasures( 2 ).resize( mesh.nbFaces() );
+      for ( PolygonMesh::Face f = 0; f < mesh.nbFaces(); ++f )
+        area.kMeasures( 2 )[ f ] = mesh.faceArea( f );
+      RealPoints centers;
+      Faces      faces;
+      for ( PolygonMesh::Face f = 0; f < mesh.nbFaces(); f += 17 )
+        {
+          centers.push_back( mesh.faceCentroid( f ) );
+          faces.push_back( f );
+        }
+      auto m_hint  = area.measures( centers, 0.4, faces );
+      auto m_index = area.measures( centers, 0.4, index );
+      for ( std::size_t i = 0; i < centers.size(); ++i )
+        {
+          const auto expected = bruteForceFacesInclusions( mesh, centers[ i ], 0.4 );
+          REQUIRE( m_index[ i ] == Approx( area.faceMeasure( expected ) ) );
+          // Face hints only gather faces connected to the hint in the ball.
+          REQUIRE( m_index[ i ] >= m_hint[ i ] - 1e-12 );
+        }
+    }
+  }
+}
+
+SCENARIO( "SurfaceMeshSpatialIndex< RealPoint3 > invalidation", "[surfmesh][spatialindex]" )
+{
+  std::mt19937 gen( 11 );
+  GIVEN( "A torus with radii 3 and 1 and its spatial index" ) {
+    PolygonMesh mesh = PolygonMeshHelper::makeTorus( 3.0, 1.0, RealPoint::zero,
+                                                     20, 30, 0, NormalsType::NO_NORMALS );
+    SpatialIndex index( mesh );
+    const RealPoints points = randomPoints( gen, 60, 5.0 );
+    WHEN( "A few vertices are moved and invalidated" ) {
+      PolygonMesh::Vertices moved;
+      std::size_t nb_incident = 0;
+      for ( PolygonMesh::Vertex v = 0; v < mesh.nbVertices(); v += 50 )
+        {
+          mesh.position( v ) += RealVector( 0.8, -0.5, 1.2 );
+          moved.push_back( v );
+          nb_incident += mesh.incidentFaces( v ).size();
+        }
+      index.invalidateVertices( moved );
+      THEN( "Their incident faces are invalidated and queries are still exact" ) {
+        REQUIRE( index.nbInvalidatedFaces() > 0 );
+        REQUIRE( index.nbInvalidatedFaces() <= nb_incident );
+        checkQueries( index, points, 0.7 );
+      }
+    }
+    WHEN( "All vertices are moved and invalidated" ) {
+      PolygonMesh::Vertices moved;
+      for ( PolygonMesh::Vertex v = 0; v < mesh.nbVertices(); ++v )
+        {
+          mesh.position( v ) *= 1.2;
+          moved.push_back( v );
+        }
+      index.invalidateVertices( moved );
+      THEN( "The index has been rebuilt and queries are still exact" ) {
+        REQUIRE( index.nbInvalidatedFaces() < mesh.nbFaces() );
+        checkQueries( index, points, 0.7 );
+      }
+    }
+  }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -618,5 +618,78 @@ SCENARIO( "CubicalComplex< K2,std::map<> > set operations and relations", "[cubi
   bool X1bd_equal_X1boundary = X1bd == X1.boundary();
   REQUIRE( X1bd_equal_X1boundary );
 }
+
+SCENARIO( "CubicalComplex< K3,std::unordered_map<> > global operations cell per cell", "[cubical_complex][global]" )
+{
+  typedef KhalimskySpaceND<3>                       KSpace;
+  typedef KSpace::Point                             Point;
+  typedef KSpace::Cell                              Cell;
+  typedef std::unordered_map<Cell, CubicalCellData> Map;
+  typedef CubicalComplex< KSpace, Map >             CC;
+
+  srand( 0 );
+  KSpace K;
+  K.init( Point( 0,0,0 ), Point( 32,32,32 ), true );
+
+  GIVEN( "A cubical complex made of random cells of all dimensions" ) {
+    CC X( K );
+    for ( int n = 0; n < 4*NBCELLS; ++n )
+      X.insertCell( K.uCell( Point( rand() % 65, rand() % 65, rand() % 65 ) ) );
+    CC S( K );
+    for ( auto it = X.begin(), itE = X.end(); it != itE; ++it )
+      if ( rand() % 4 == 0 ) S.insertCell( *it );
+
+    THEN( "Its closure contains exactly the cells and their faces" ) {
+      CC cl_X = X;
+      cl_X.close();
+      CC expected = X;
+      for ( auto it = X.begin(), itE = X.end(); it != itE; ++it )
+        {
+          auto faces = K.uFaces( *it );
+          expected.insert( faces.begin(), faces.end() );
+        }
+      REQUIRE( cl_X == expected );
+      REQUIRE( cl_X.closure( X ) == expected );
+    }
+    THEN( "Its opening contains exactly the cells whose cofaces all belong to it" ) {
+      CC op_X = X;
+      op_X.open();
+      CC expected( K );
+      for ( auto it = X.begin(), itE = X.end(); it != itE; ++it )
+        {
+          auto cofaces = K.uCoFaces( *it );
+          bool open = true;
+          for ( auto c : cofaces ) open = open && X.belongs( c );
+          if ( open ) expected.insertCell( *it );
+        }
+      REQUIRE( op_X == expected );
+      REQUIRE( X.interior() == expected );
+    }
+    THEN( "Its boundary and interior partition its closure" ) {
+      CC intX( K ), bdX( K );
+      X.getInteriorAndBoundary( intX, bdX );
+      CC cl_X = ~X;
+      REQUIRE( ( intX & bdX ).empty() );
+      REQUIRE( ( intX | bdX ) == cl_X );
+      REQUIRE( bdX == X.boundary() );
+      REQUIRE( intX == cl_X.interior() );
+      for ( auto it = bdX.begin(), itE = bdX.end(); it != itE; ++it )
+        REQUIRE( ! cl_X.isCellInterior( *it ) );
+    }
+    THEN( "The star of a subcomplex contains exactly the cells having a face in it" ) {
+      CC star_S = X.star( S );
+      CC expected( K );
+      for ( auto it = X.begin(), itE = X.end(); it != itE; ++it )
+        {
+          bool in_star = S.belongs( *it );
+          auto faces = K.uFaces( *it );
+          for ( auto c : faces ) in_star = in_star || S.belongs( c );
+          if ( in_star ) expected.insertCell( *it );
+        }
+      REQUIRE( star_S == expected );
+    }
+  }
+}
+
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,202 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testFlatDigitalSurface.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class FlatDigitalSurface.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/helpers/Shortcuts.h"
+#include "DGtal/helpers/ShortcutsGeometry.h"
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/topology/CDigitalSurfaceContainer.h"
+#include "DGtal/topology/LightImplicitDigitalSurface.h"
+#include "DGtal/topology/DigitalSurface.h"
+#include "DGtal/topology/FlatDigitalSurface.h"
+#include "DGtal/topology/helpers/Surfaces.h"
+#include "DGtal/graph/BreadthFirstVisitor.h"
+#include "DGtal/graph/GraphVisitorRange.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+using namespace Z3i;
+
+typedef ImageContainerBySTLVector<Domain, bool> BinaryImage;
+typedef FlatDigitalSurface<KSpace> FlatContainer;
+typedef LightImplicitDigitalSurface<KSpace, BinaryImage> LightContainer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class FlatDigitalSurface.
+///////////////////////////////////////////////////////////////////////////////
+
+SCENARIO( "FlatDigitalSurface build and tracking tests", "[flatdsurf]" )
+{
+  BOOST_CONCEPT_ASSERT(( concepts::CDigitalSurfaceContainer< FlatContainer > ));
+
+  // Two disjoint balls, the second one being touched by the domain border.
+  const Domain domain( Point( -10, -6, -6 ), Point( 12, 6, 6 ) );
+  BinaryImage image( domain );
+  for ( auto p : domain )
+    image.setValue( p, ( p - Point( -4, 0, 0 ) ).norm() <= 4.5
+                    || ( p - Point( 9, 1, 0 ) ).norm() <= 4.0 );
+  KSpace K;
+  K.init( domain.lowerBound(), domain.upperBound(), true );
+
+  KSpace::SCellSet boundary;
+  Surfaces<KSpace>::sMakeBoundary( boundary, K, image,
+                                   domain.lowerBound(), domain.upperBound() );
+
+  for ( bool interior : { true, false } )
+    {
+      SurfelAdjacency<KSpace::dimension> adj( interior );
+      FlatContainer flat( K, image, adj );
+      GIVEN( std::string( "A flat container over two balls, " )
+             + ( interior ? "interior" : "exterior" ) + " adjacency" ) {
+        THEN( "It is valid and contains the whole boundary, sorted by codes" ) {
+          REQUIRE( flat.isValid() );
+          REQUIRE( flat.nbSurfels() == boundary.size() );
+          REQUIRE( flat.connectedness() == DISCONNECTED );
+          for ( auto s : boundary )
+            REQUIRE( flat.isInside( s ) );
+          REQUIRE( ! flat.isInside( K.sOpp( *boundary.begin() ) ) );
+          FlatContainer::Index i = 0;
+          for ( auto it = flat.begin(), itE = flat.end(); it != itE; ++it, ++i )
+            {
+              REQUIRE( flat.index( *it ) == i );
+              if ( i > 0 ) REQUIRE( flat.code( *( it - 1 ) ) < flat.code( *it ) );
+            }
+        }
+        THEN( "Its tracker gives the same adjacent surfels as the one of LightImplicitDigitalSurface" ) {
+          LightContainer light( K, image, adj, *boundary.begin() );
+          std::unique_ptr<FlatContainer::Tracker> flat_tracker( flat.newTracker( *flat.begin() ) );
+          unsigned int nb = 0;
+          for ( auto s : flat )
+            {
+              std::unique_ptr<LightContainer::Tracker> light_tracker( light.newTracker( s ) );
+              flat_tracker->move( s );
+              REQUIRE( flat_tracker->current() == s );
+              REQUIRE( flat_tracker->orthDir() == K.sOrthDir( s ) );
+              for ( Dimension d = 0; d < KSpace::dimension; ++d )
+                {
+                  if ( d == K.sOrthDir( s ) ) continue;
+                  for ( bool pos : { false, true } )
+                    {
+                      SCell t_flat = s;
+                      SCell t_light = s;
+                      const uint8_t c_flat  = flat_tracker->adjacent( t_flat, d, pos );
+                      const uint8_t c_light = light_tracker->adjacent( t_light, d, pos );
+                      REQUIRE( c_flat == c_light );
+                      REQUIRE( t_flat == t_light );
+                      nb += ( c_flat != 0 ) ? 1 : 0;
+                    }
+                }
+            }
+          REQUIRE( nb > 0 );
+        }
+        THEN( "A breadth-first traversal of the first component gives the same surfels as with a light surface" ) {
+          DigitalSurface<FlatContainer> flat_surface( flat );
+          DigitalSurface<LightContainer> light_surface( new LightContainer( K, image, adj, *flat.begin() ) );
+          typedef BreadthFirstVisitor< DigitalSurface<FlatContainer> > Visitor;
+          GraphVisitorRange<Visitor> range( new Visitor( flat_surface, *flat.begin() ) );
+          KSpace::SCellSet visited( range.begin(), range.end() );
+          KSpace::SCellSet expected( light_surface.begin(), light_surface.end() );
+          REQUIRE( visited == expected );
+          REQUIRE( visited.size() < flat.nbSurfels() );
+        }
+        THEN( "Its connected components are the ones given by tracking" ) {
+          REQUIRE( flat.nbComponents() == 2 );
+          std::vector< std::vector<SCell> > components;
+          Surfaces<KSpace>::extractAllConnectedSCell( components, K, adj, image );
+          // Sequential tracking from the smallest remaining surfel.
+          std::vector< std::vector<SCell> > expected;
+          KSpace::SCellSet bdry = boundary;
+          while ( ! bdry.empty() )
+            {
+              KSpace::SCellSet component;
+              Surfaces<KSpace>::trackBoundary( component, K, adj, image, *bdry.begin() );
+              for ( auto s : component ) bdry.erase( s );
+              expected.push_back( std::vector<SCell>( component.begin(), component.end() ) );
+            }
+          REQUIRE( components == expected );
+          // Each label of the flat container is a whole tracked component.
+          std::vector<std::size_t> which( flat.nbComponents(), components.size() );
+          for ( FlatContainer::Index i = 0; i < flat.nbSurfels(); ++i )
+            {
+              const FlatContainer::Index c = flat.component( i );
+              if ( which[ c ] == components.size() )
+                for ( std::size_t k = 0; k < components.size(); ++k )
+                  if ( std::binary_search( components[ k ].begin(), components[ k ].end(),
+                                           flat.surfel( i ) ) )
+                    which[ c ] = k;
+              REQUIRE( which[ c ] < components.size() );
+              REQUIRE( std::binary_search( components[ which[ c ] ].begin(),
+                                           components[ which[ c ] ].end(), flat.surfel( i ) ) );
+            }
+          REQUIRE( which[ 0 ] != which[ 1 ] );
+        }
+      }
+    }
+}
+
+SCENARIO( "FlatDigitalSurface with Shortcuts", "[flatdsurf][shortcuts]" )
+{
+  typedef Shortcuts<KSpace> SH3;
+  typedef ShortcutsGeometry<KSpace> SHG3;
+  auto params = SH3::defaultParameters() | SHG3::defaultParameters();
+  params( "polynomial", "goursat" )( "gridstep", 1.0 );
+  auto implicit_shape  = SH3::makeImplicitShape3D( params );
+  auto digitized_shape = SH3::makeDigitizedImplicitShape3D( implicit_shape, params );
+  auto bimage          = SH3::makeBinaryImage( digitized_shape, params );
+  auto K               = SH3::getKSpace( bimage, params );
+  auto light_surface   = SH3::makeLightDigitalSurface( bimage, K, params );
+  auto flat_surface    = SH3::makeFlatDigitalSurface( bimage, K, params );
+  GIVEN( "A flat digital surface and a light digital surface over a Goursat shape" ) {
+    auto surfels = SH3::getSurfelRange( light_surface, params( "surfaceTraversal", "DepthFirst" ) );
+    THEN( "Both surfaces have the same surfels" ) {
+      REQUIRE( flat_surface->size() == light_surface->size() );
+      auto flat_surfels = SH3::getSurfelRange( flat_surface, *surfels.begin(), params );
+      REQUIRE( flat_surfels == surfels );
+    }
+    THEN( "All light digital surfaces are represented by their smallest surfel" ) {
+      SH3::SurfelRange reps;
+      auto surfaces = SH3::makeLightDigitalSurfaces( reps, bimage, K, params( "surfaceComponents", "All" ) );
+      REQUIRE( surfaces.size() == flat_surface->container().nbComponents() );
+      REQUIRE( reps.size() == surfaces.size() );
+      REQUIRE( reps[ 0 ] == *std::min_element( flat_surface->begin(), flat_surface->end() ) );
+      REQUIRE( surfaces[ 0 ]->size() == light_surface->size() );
+    }
+    THEN( "Convolved trivial normals are the same on both surfaces" ) {
+      auto flat_normals  = SHG3::getCTrivialNormalVectors( flat_surface, surfels, params );
+      auto light_normals = SHG3::getCTrivialNormalVectors( light_surface, surfels, params );
+      REQUIRE( flat_normals == light_normals );
+    }
+  }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
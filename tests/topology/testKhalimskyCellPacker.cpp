@@ -0,0 +1,151 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testKhalimskyCellPacker.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class KhalimskyCellPacker.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <set>
+#include <unordered_set>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtalCatch.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/topology/KhalimskySpaceND.h"
+#include "DGtal/topology/KhalimskyCellPacker.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class KhalimskyCellPacker.
+///////////////////////////////////////////////////////////////////////////////
+
+/// Checks that all cells of the space are packed into distinct
+/// codes and unpacked back.
+template <typename Packer>
+void checkAllCells( const Packer & packer )
+{
+  typedef typename Packer::KSpace KSpace;
+  typedef typename KSpace::Cell Cell;
+  typedef typename KSpace::SCell SCell;
+  typedef HyperRectDomain<typename KSpace::Space> KDomain;
+  const KSpace & K = packer.space();
+  REQUIRE( packer.isValid() );
+  std::set<typename Packer::Code> codes;
+  std::size_t nb = 0;
+  const KDomain kdomain( K.lowerCell().preCell().coordinates,
+                         K.upperCell().preCell().coordinates );
+  for ( auto kp : kdomain )
+    {
+      const Cell c = K.uCell( kp );
+      const auto code = packer.code( c );
+      REQUIRE( code < ( typename Packer::Code( 1 ) << packer.nbBits() ) );
+      REQUIRE( packer.cell( code ) == c );
+      codes.insert( code );
+      ++nb;
+      for ( bool pos : { true, false } )
+        {
+          const SCell s = K.signs( c, pos );
+          const auto scode = packer.code( s );
+          REQUIRE( ( scode >> 1 ) == code );
+          REQUIRE( packer.sCell( scode ) == s );
+        }
+    }
+  REQUIRE( codes.size() == nb );
+}
+
+TEST_CASE( "Testing KhalimskyCellPacker" )
+{
+  typedef KhalimskyCellPacker<Z2i::KSpace, LinearCellPacking> LinearPacker2;
+  typedef KhalimskyCellPacker<Z2i::KSpace, MortonCellPacking> MortonPacker2;
+  typedef KhalimskyCellPacker<Z3i::KSpace, LinearCellPacking> LinearPacker3;
+  typedef KhalimskyCellPacker<Z3i::KSpace, MortonCellPacking> MortonPacker3;
+
+  SECTION( "Cells are packed and unpacked in closed, open and periodic spaces" )
+    {
+      for ( auto closure : { Z2i::KSpace::CLOSED, Z2i::KSpace::OPEN, Z2i::KSpace::PERIODIC } )
+        {
+          Z2i::KSpace K2;
+          REQUIRE( K2.init( Z2i::Point( -3, 2 ), Z2i::Point( 4, 7 ), closure ) );
+          checkAllCells( LinearPacker2( K2 ) );
+          checkAllCells( MortonPacker2( K2 ) );
+          Z3i::KSpace K3;
+          REQUIRE( K3.init( Z3i::Point( -2, 0, 1 ), Z3i::Point( 2, 3, 5 ), closure ) );
+          checkAllCells( LinearPacker3( K3 ) );
+          checkAllCells( MortonPacker3( K3 ) );
+        }
+    }
+
+  SECTION( "Linear codes follow the lexicographic order of Khalimsky coordinates" )
+    {
+      Z3i::KSpace K;
+      REQUIRE( K.init( Z3i::Point( -2, 0, 1 ), Z3i::Point( 2, 3, 5 ), true ) );
+      LinearPacker3 packer( K );
+      const Z3i::Cell a = K.uCell( Z3i::Point( 4, 0, 2 ) );
+      const Z3i::Cell b = K.uCell( Z3i::Point( -4, 1, 2 ) );
+      const Z3i::Cell c = K.uCell( Z3i::Point( -4, 0, 3 ) );
+      REQUIRE( packer.code( a ) < packer.code( b ) );
+      REQUIRE( packer.code( b ) < packer.code( c ) );
+      REQUIRE( packer.nbBits() == 4 + 4 + 4 );
+      REQUIRE( MortonPacker3( K ).nbBits() == 3 * 4 );
+    }
+
+  SECTION( "Hash and Less functors work with standard containers" )
+    {
+      Z3i::KSpace K;
+      REQUIRE( K.init( Z3i::Point( 0, 0, 0 ), Z3i::Point( 9, 9, 9 ), true ) );
+      MortonPacker3 packer( K );
+      std::unordered_set<Z3i::SCell, MortonPacker3::Hash> hashed( 0, packer.hash() );
+      std::set<Z3i::SCell, MortonPacker3::Less> ordered( packer.less() );
+      std::set<Z3i::SCell> expected;
+      for ( auto p : Z3i::Domain( Z3i::Point( 2, 3, 4 ), Z3i::Point( 6, 7, 8 ) ) )
+        {
+          const Z3i::SCell s = K.sIncident( K.sSpel( p ), p[ 0 ] % 3, p[ 1 ] % 2 == 0 );
+          hashed.insert( s );
+          ordered.insert( s );
+          expected.insert( s );
+        }
+      REQUIRE( hashed.size() == expected.size() );
+      REQUIRE( ordered.size() == expected.size() );
+      for ( auto s : expected )
+        {
+          REQUIRE( hashed.count( s ) == 1 );
+          REQUIRE( ordered.count( s ) == 1 );
+        }
+      REQUIRE( std::is_sorted( ordered.begin(), ordered.end(),
+                               [ &packer ] ( const Z3i::SCell & s1, const Z3i::SCell & s2 )
+                               { return packer.code( s1 ) < packer.code( s2 ); } ) );
+      REQUIRE( sizeof( MortonPacker3::Code ) < sizeof( Z3i::SCell ) );
+    }
+
+  SECTION( "Codes of too big spaces do not fit in 64 bits" )
+    {
+      typedef KhalimskySpaceND<3, DGtal::int64_t> KSpace;
+      KSpace K;
+      REQUIRE( K.init( KSpace::Point::diagonal( 0 ), KSpace::Point::diagonal( 1 << 22 ), true ) );
+      REQUIRE( ! KhalimskyCellPacker<KSpace>( K ).isValid() );
+    }
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////